@@ -0,0 +1,253 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file admission.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the fair admission queue.
+ *
+ */
+
+#include <errno.h>
+#include "admission.h"
+#include "timesource.h"
+#include "tools.h"
+
+/**
+ * @brief Takes a free unit without the lock
+ * @param admission* The queue
+ * @return True, if a unit was free and is held by the caller now, false otherwise
+ *
+ * Units are only free while nobody waits, so taking one never overtakes a waiter.
+ *
+ * */
+static inline bool take_free(admission *q) {
+    int n = __atomic_load_n(&q->available, __ATOMIC_RELAXED);
+    while (n > 0) {
+        if (__atomic_compare_exchange_n(&q->available, &n, n - 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            return true;
+        /* n has been reloaded by the failed exchange */
+    }
+    return false;
+}
+
+/**
+ * @brief Appends a waiter to the queue
+ * @param admission* The queue, locked by the caller
+ * @param admission_waiter* The waiter
+ *
+ * */
+static void join_queue(admission *q, admission_waiter *w) {
+    w->granted = false;
+    w->next = NULL;
+    if (q->tail == NULL)
+        q->head = w;
+    else
+        q->tail->next = w;
+    q->tail = w;
+    __atomic_store_n(&q->waiting, q->waiting + 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Removes a waiter from the queue
+ * @param admission* The queue, locked by the caller
+ * @param admission_waiter* The waiter
+ * @return True, if the waiter was queued, false otherwise
+ *
+ * */
+static bool leave_queue(admission *q, admission_waiter *w) {
+    admission_waiter *prev = NULL;
+    admission_waiter *it = q->head;
+    while (it != NULL && it != w) {
+        prev = it;
+        it = it->next;
+    }
+    if (it == NULL)
+        return false;
+    if (prev == NULL)
+        q->head = w->next;
+    else
+        prev->next = w->next;
+    if (q->tail == w)
+        q->tail = prev;
+    __atomic_store_n(&q->waiting, q->waiting - 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+/**
+ * @brief Calls back tasks, which left the queue
+ * @param admission_waiter* First of the waiters, linked by their next field
+ *
+ * */
+static void call_back(admission_waiter *w) {
+    while (w != NULL) {
+        /* the task may queue again as soon as it is called back */
+        admission_waiter *next = w->next;
+        w->fn(w->arg);
+        w = next;
+    }
+}
+
+/**
+ * @brief Wakes up all waiters, so that they notice the cancellation
+ * @param void* The queue
+ *
+ * Waiting threads are signalled, waiting tasks are taken out of the queue and called back.
+ *
+ * */
+static void wake_all(void *arg) {
+    admission *q = arg;
+    admission_waiter *tasks = NULL;
+    lockstat_lock(&q->lock);
+    admission_waiter *w = q->head;
+    while (w != NULL) {
+        admission_waiter *next = w->next;
+        if (w->fn == NULL) {
+            pthread_cond_signal(&w->cond);
+        } else {
+            leave_queue(q, w);
+            w->next = tasks;
+            tasks = w;
+        }
+        w = next;
+    }
+    lockstat_unlock(&q->lock);
+    call_back(tasks);
+}
+
+void admission_init(admission *q, int units, const char *name) {
+    lockstat_init(&q->lock, name);
+    q->available = units;
+    q->waiting = 0;
+    q->head = NULL;
+    q->tail = NULL;
+    cancel_watch_add(&q->watch, wake_all, q);
+}
+
+bool admission_trywait(admission *q) {
+    /* neither taking a free unit nor failing on a full or empty airport needs the lock */
+    return take_free(q);
+}
+
+bool admission_wait(admission *q, const struct timespec *deadline, time_t *queued) {
+    *queued = 0;
+    if (!cancel_requested() && take_free(q))
+        return true;
+    lockstat_lock(&q->lock);
+    /* checked with the lock held, so that a request either comes first or wakes us up */
+    if (cancel_requested()) {
+        lockstat_unlock(&q->lock);
+        return false;
+    }
+    /* a unit may have been released, before the lock was taken */
+    if (take_free(q)) {
+        lockstat_unlock(&q->lock);
+        return true;
+    }
+
+    /* get in line */
+    time_t start = current_timestamp();
+    admission_waiter w;
+    timesource_cond_init(&w.cond);
+    w.fn = NULL;
+    join_queue(q, &w);
+
+    while (!w.granted) {
+        if (cancel_requested() || lockstat_timedwait(&q->lock, &w.cond, deadline) == ETIMEDOUT) {
+            if (!w.granted)
+                leave_queue(q, &w);
+            break;
+        }
+    }
+    lockstat_unlock(&q->lock);
+    pthread_cond_destroy(&w.cond);
+    *queued = current_timestamp() - start;
+    return w.granted;
+}
+
+void admission_waiter_init(admission_waiter *w, admission_fn fn, void *arg) {
+    w->fn = fn;
+    w->arg = arg;
+    w->deadline = 0;
+    w->granted = false;
+    w->next = NULL;
+}
+
+bool admission_enqueue(admission *q, admission_waiter *w) {
+    if (!cancel_requested() && take_free(q))
+        return true;
+    lockstat_lock(&q->lock);
+    if (take_free(q)) {
+        lockstat_unlock(&q->lock);
+        return true;
+    }
+    /* checked with the lock held, so that a request either comes first or takes the waiter out again */
+    bool cancelled = cancel_requested();
+    if (cancelled) {
+        w->granted = false;
+        w->next = NULL;
+    } else {
+        join_queue(q, w);
+    }
+    lockstat_unlock(&q->lock);
+    if (cancelled)
+        call_back(w);
+    return false;
+}
+
+bool admission_expire(admission *q, admission_waiter *w, time_t now) {
+    lockstat_lock(&q->lock);
+    admission_waiter *it = q->head;
+    while (it != NULL && it != w)
+        it = it->next;
+    /* the deadline is only read while the waiter is queued, as the task changes it before it queues again */
+    bool expired = it != NULL && now >= w->deadline;
+    if (expired)
+        leave_queue(q, w);
+    lockstat_unlock(&q->lock);
+    return expired;
+}
+
+void admission_post(admission *q) {
+    lockstat_lock(&q->lock);
+    admission_waiter *w = q->head;
+    if (w == NULL) {
+        /* added atomically, as take_free() decrements without the lock */
+        __atomic_add_fetch(&q->available, 1, __ATOMIC_RELEASE);
+        lockstat_unlock(&q->lock);
+        return;
+    }
+    /* hand the unit over, so that nobody can take it before the first waiter wakes up */
+    q->head = w->next;
+    if (q->head == NULL)
+        q->tail = NULL;
+    __atomic_store_n(&q->waiting, q->waiting - 1, __ATOMIC_RELAXED);
+    w->granted = true;
+    if (w->fn == NULL) {
+        /* signalled with the lock held, as the waiter frees w as soon as it sees it granted */
+        pthread_cond_signal(&w->cond);
+        lockstat_unlock(&q->lock);
+        return;
+    }
+    w->next = NULL;
+    lockstat_unlock(&q->lock);
+    call_back(w);
+}
+
+int admission_get_value(admission *q) {
+    return __atomic_load_n(&q->available, __ATOMIC_RELAXED);
+}
+
+int admission_get_waiting(admission *q) {
+    return __atomic_load_n(&q->waiting, __ATOMIC_RELAXED);
+}
+
+void admission_destroy(admission *q) {
+    cancel_watch_remove(&q->watch);
+    lockstat_destroy(&q->lock);
+}
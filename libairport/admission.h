@@ -0,0 +1,165 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file admission.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the fair admission queue.
+ *
+ * An admission queue is a counting semaphore, which grants its units in arrival order. A thread, which finds no free
+ * unit, appends itself to a queue of waiters. A released unit is handed to the first waiter directly, so a thread
+ * arriving later can never overtake a waiting one, and every waiter learns how long it queued. Tasks, which must not
+ * block a thread, get in line with admission_enqueue() instead and are called back when they got their unit. When
+ * cancellation is requested, all waiters leave their queues at once.
+ *
+ */
+
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <time.h>
+#include "cancel.h"
+#include "lockstat.h"
+
+/**
+ * @brief Function called back, when a queued task got its unit or has to leave the queue
+ *
+ * */
+typedef void (*admission_fn)(void *);
+
+/**
+ * @brief A thread or task waiting for a unit
+ *
+ * A waiting thread keeps it on its stack, a task keeps it for as long as it may queue.
+ *
+ * */
+typedef struct admission_waiter {
+    pthread_cond_t cond; /**< Signalled, when the waiting thread got its unit. */
+    admission_fn fn; /**< Called back, when the waiting task got its unit, NULL for a thread. */
+    void *arg; /**< Argument passed to fn. */
+    time_t deadline; /**< Time the task gives up waiting, as returned by current_timestamp(), see admission_expire(). */
+    bool granted; /**< A unit was handed to the waiter. */
+    struct admission_waiter *next; /**< Next waiter in line. */
+} admission_waiter;
+
+/**
+ * @brief Admission queue
+ *
+ * The structure must not be copied.
+ *
+ * */
+typedef struct admission {
+    lockstat lock; /**< Protects the queue of waiters. */
+    int available; /**< Number of free units, only greater than 0 while nobody waits, changed atomically. */
+    int waiting; /**< Number of queued threads and tasks. */
+    admission_waiter *head; /**< First waiter, which gets the next released unit. */
+    admission_waiter *tail; /**< Last waiter. */
+    cancel_watch watch; /**< Wakes up the waiters when cancellation is requested. */
+} admission;
+
+/**
+ * @brief Initializes an admission queue
+ * @param admission* The queue
+ * @param int Number of free units
+ * @param char* Name the lock of the queue is profiled under, see lockstat_init()
+ *
+ * */
+void admission_init(admission *, int, const char *);
+
+/**
+ * @brief Takes a unit without blocking
+ * @param admission* The queue
+ * @return True, if a unit was free and is held by the caller now, false otherwise
+ *
+ * Fails while other threads wait, even if a unit was just released, as that unit belongs to the first waiter.
+ *
+ * */
+bool admission_trywait(admission *);
+
+/**
+ * @brief Waits in line for a unit
+ * @param admission* The queue
+ * @param timespec* Absolute time to give up at, from timesource_deadline()
+ * @param time_t* Receives the time in milliseconds the caller queued, 0 if a unit was free
+ * @return True, if the caller holds a unit now, false if the time ran out or cancellation was requested
+ *
+ * */
+bool admission_wait(admission *, const struct timespec *, time_t *);
+
+/**
+ * @brief Initializes the waiter of a task
+ * @param admission_waiter* The waiter
+ * @param admission_fn Function called back, when the task got its unit or has to leave the queue
+ * @param void* Argument passed to the function
+ *
+ * */
+void admission_waiter_init(admission_waiter *, admission_fn, void *);
+
+/**
+ * @brief Takes a unit, or gets in line without blocking
+ * @param admission* The queue
+ * @param admission_waiter* The waiter of the task, which must not be queued already
+ * @return True, if a unit was free and is held by the caller now, false if the waiter is called back later
+ *
+ * The function of a queued waiter is called exactly once, by the thread handing over the unit or requesting
+ * cancellation, without the lock of the queue held. Its granted field then tells whether the task holds a unit. When
+ * cancellation was requested before, the waiter is called back at once. A function called because of cancellation runs
+ * while the watches of the cancellation token are locked, see cancel_watch_add(), so it may use the token, but must
+ * neither initialize nor destroy an admission queue.
+ *
+ * */
+bool admission_enqueue(admission *, admission_waiter *);
+
+/**
+ * @brief Takes a waiter, whose deadline has passed, out of the line
+ * @param admission* The queue
+ * @param admission_waiter* The waiter, which may have left the queue already
+ * @param time_t Current time
+ * @return True, if the waiter was still queued and its deadline has passed, so that it will not be called back,
+ * false otherwise
+ *
+ * A timer armed for an earlier wait of the same waiter finds a later deadline and leaves the waiter in line.
+ *
+ * */
+bool admission_expire(admission *, admission_waiter *, time_t);
+
+/**
+ * @brief Releases a unit
+ * @param admission* The queue
+ *
+ * The unit is handed to the first waiter, if there is one.
+ *
+ * */
+void admission_post(admission *);
+
+/**
+ * @brief Gets the number of free units
+ * @param admission* The queue
+ * @return Number of free units, which may be outdated as soon as it is returned
+ *
+ * */
+int admission_get_value(admission *);
+
+/**
+ * @brief Gets the number of waiting threads
+ * @param admission* The queue
+ * @return Number of queued threads and tasks, which may be outdated as soon as it is returned
+ *
+ * */
+int admission_get_waiting(admission *);
+
+/**
+ * @brief Destroys an admission queue
+ * @param admission* The queue, which nobody may wait for anymore
+ *
+ * */
+void admission_destroy(admission *);
+
+#endif /* ADMISSION_H */
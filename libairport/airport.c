@@ -0,0 +1,806 @@
+/****************************************************************************
+* Copyright (C) 2014 by Lukas Elsner                                       *
+*                                                                          *
+* This file is part of airport-sim.                                        *
+*                                                                          *
+****************************************************************************/
+
+/**
+* @file airport.c
+* @author Lukas Elsner
+* @date 01-09-2014
+* @brief File containing public methods for airport class.
+*
+* The airport is the main data structure of this application. It provides the parking bays and thread safe
+* take-off and landing functionality.
+*
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "airport.h"
+#include "admission.h"
+#include "cancel.h"
+#include "timesource.h"
+#include "tools.h"
+#include "trace.h"
+#include "bay.h"
+#include "bayindex.h"
+#include "lockstat.h"
+#include "logger.h"
+#include "stats.h"
+#include "strbuf.h"
+
+/**
+* @brief Size of a cache line in bytes
+*
+*/
+#define CACHE_LINE 64
+
+/**
+* @brief Zone of consecutive bays with its own lock
+*
+*/
+typedef struct bay_shard {
+    lockstat lock; /**< Protects the bays of the zone and index. */
+    bayindex *index; /**< State of the bays of the zone, by bay number relative to first. */
+    int first; /**< Number of the first bay of the zone. */
+    int num_free; /**< Number of free bays, can be read without the lock to skip full zones. */
+    int num_occupied; /**< Number of bays with a parked plane, can be read without the lock to skip empty zones. */
+    unsigned long seq; /**< Sequence number of the views of the zone's bays, odd while they are changed. */
+    char pad[CACHE_LINE]; /**< Keeps the locks of neighbouring zones on different cache lines. */
+} bay_shard;
+
+/**
+* @brief Compact copy of the state of a bay, which can be read without the lock of its zone
+*
+* Views are only changed by the holder of the zone lock, between two increments of the zone's sequence number. A
+* reader copies the views of a zone and retries, if the sequence number was odd or has changed in the meantime.
+* All fields are accessed with relaxed atomic operations.
+*
+*/
+typedef struct bay_view {
+    uint64_t name; /**< Name of the parked plane, zero padded, or 0 if no plane is parked. */
+    time_t parked_at; /**< Time the plane was parked. */
+    int runway; /**< Runway the plane landed on. */
+} bay_view;
+
+/**
+* @brief Number of runways, whose state fits into one word of the runway mask
+*
+*/
+#define RUNWAYS_PER_WORD 64
+
+/**
+* @brief Runway structure for representing a runway and its usage
+*
+*/
+typedef struct runway {
+    unsigned long operations; /**< Number of finished landings and take-offs on this runway. */
+    time_t busy_time; /**< Time in milliseconds the runway was in use. */
+    time_t acquired; /**< Time the runway was acquired by the current operation. */
+    char pad[CACHE_LINE]; /**< Keeps neighbouring runways on different cache lines. */
+} runway;
+
+/**
+* @brief Airport structure for representing an instance of an airport
+*
+*/
+struct airport {
+    char *name;
+    /**< Name of the airport. */
+    int num_bays;
+    /**< Number of parking slots the airport supplies. */
+    int num_runways;
+    /**< Number of runways the airport supplies. */
+    int num_shards;
+    /**< Number of bay zones, one per runway, but never more than there are bays. */
+    bay **bays;
+    /**< Bays in which planes can be parked. Has length num_bays. */
+    bay_shard *shards;
+    /**< Zones of bays, each bay is protected by the lock of its zone. Has length num_shards. */
+    bay_view *views;
+    /**< Snapshot of every bay for observers, protected by the sequence number of its zone. Has length num_bays. */
+    int shard_size;
+    /**< Number of bays per zone, the last zone may be smaller. */
+    admission empty;
+    /**< Free bays, landing planes queue here while the airport is full. */
+    admission full;
+    /**< Parked planes, take-offs queue here while the airport is empty. */
+    admission runways;
+    /**< Free runways, landings and take-offs queue here while all runways are in use. */
+    runway *runway_list;
+    /**< All runways, each is used by one plane at a time. Has length num_runways. */
+#ifndef AIRPORT_SINGLE_RUNWAY
+    uint64_t *runway_mask;
+    /**< One bit per runway, set while the runway is in use. Changed with atomic operations only. */
+#endif
+};
+
+
+/**
+* @brief Checks if a airport is empty
+* @param airport* Pointer to structure to work on
+* @return True, if the airport is empty, false otherwise
+*
+* This method queries the empty-queue to check if the given airport is empty.
+*
+* */
+bool airport_is_empty(airport *ap) {
+    return admission_get_value(&ap->empty) == ap->num_bays;
+}
+
+/**
+* @brief Checks if a airport is full
+* @param airport* Pointer to structure to work on
+* @return True, if the airport is full, false otherwise
+*
+* This method queries the full-queue to check if the given airport is full.
+*
+* */
+bool airport_is_full(airport *ap) {
+    return admission_get_value(&ap->full) == ap->num_bays;
+}
+
+/**
+* @brief Gets the zone of a bay
+* @param airport* Pointer to structure to work on
+* @param int Number of the bay
+* @return The zone the bay belongs to
+*
+* */
+static bay_shard *shard_of(airport *ap, int bay_nr) {
+    return &ap->shards[bay_nr / ap->shard_size];
+}
+
+/**
+* @brief Updates the state of a bay and the counters of its zone
+* @param bay_shard* Zone of the bay
+* @param int Number of the bay
+* @param int New state of the bay
+*
+* The caller has to hold the lock of the zone.
+*
+* */
+static void set_bay_state(bay_shard *sh, int bay_nr, int state) {
+    bayindex_set(sh->index, bay_nr - sh->first, state);
+    __atomic_store_n(&sh->num_free, bayindex_count(sh->index, BAY_FREE), __ATOMIC_RELAXED);
+    __atomic_store_n(&sh->num_occupied, bayindex_count(sh->index, BAY_OCCUPIED), __ATOMIC_RELAXED);
+}
+
+/**
+* @brief Updates the view of a bay
+* @param airport* Pointer to structure to work on
+* @param bay_shard* Zone of the bay
+* @param int Number of the bay
+*
+* The caller has to hold the lock of the zone. Readers of the zone's views retry while the view is changed.
+*
+* */
+static void publish_bay(airport *ap, bay_shard *sh, int bay_nr) {
+    bay *b = ap->bays[bay_nr];
+    bay_view *v = &ap->views[bay_nr];
+    uint64_t name = 0;
+    if (b != NULL && bay_get_plane(b) != NULL)
+        strncpy((char *) &name, plane_get_name(bay_get_plane(b)), sizeof(name));
+
+    unsigned long seq = sh->seq;
+    __atomic_store_n(&sh->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&v->name, name, __ATOMIC_RELAXED);
+    if (name != 0) {
+        __atomic_store_n(&v->parked_at, bay_get_parking_time(b), __ATOMIC_RELAXED);
+        __atomic_store_n(&v->runway, bay_get_runway(b), __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&sh->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+/**
+* @brief Copies the views of all bays of a zone without taking its lock
+* @param airport* Pointer to structure to work on
+* @param bay_shard* The zone
+* @param int Number of bays in the zone
+* @param bay_view* Receives the views, must hold the given number of views
+*
+* The copy is consistent: it shows the zone as it was between two changes.
+*
+* */
+static void read_zone(airport *ap, bay_shard *sh, int size, bay_view *copy) {
+    while (1) {
+        unsigned long seq = __atomic_load_n(&sh->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1)
+            continue;
+        for (int i = 0; i < size; ++i) {
+            bay_view *v = &ap->views[sh->first + i];
+            copy[i].name = __atomic_load_n(&v->name, __ATOMIC_RELAXED);
+            copy[i].parked_at = __atomic_load_n(&v->parked_at, __ATOMIC_RELAXED);
+            copy[i].runway = __atomic_load_n(&v->runway, __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&sh->seq, __ATOMIC_RELAXED) == seq)
+            return;
+    }
+}
+
+/**
+* @brief Locks a zone with a bay in the given state
+* @param airport* Pointer to structure to work on
+* @param int The state, BAY_FREE or BAY_OCCUPIED
+* @return The locked zone, which contains at least one bay in the given state
+*
+* The search starts at a random zone and falls back to the following zones, if it has no such bay. The caller has to
+* make sure, that such a bay exists, by holding a unit of the empty- or full-queue. Otherwise, this function never
+* returns.
+*
+* */
+static bay_shard *lock_shard_with(airport *ap, int state) {
+    int start = rng_range(ap->num_shards);
+    for (int i = 0; ; ++i) {
+        bay_shard *sh = &ap->shards[(start + i) % ap->num_shards];
+        /* skip zones without such a bay, without taking their lock */
+        int *counter = state == BAY_FREE ? &sh->num_free : &sh->num_occupied;
+        if (__atomic_load_n(counter, __ATOMIC_RELAXED) == 0)
+            continue;
+        lockstat_lock(&sh->lock);
+        if (bayindex_count(sh->index, state) > 0)
+            return sh;
+        lockstat_unlock(&sh->lock);
+    }
+}
+
+/**
+* @brief Gets a random bay number of a zone
+* @param bay_shard* Pointer to the locked zone
+* @param int The state, the bay has to be in
+* @return A random bay number
+*
+* The caller has to make sure, that there is such a bay in the zone and has to hold its lock.
+* The bay is chosen uniformly among the bays of the zone in this state in constant time.
+*
+* */
+static int get_random_bay_nr(bay_shard *sh, int state) {
+    return sh->first + bayindex_nth(sh->index, state, rng_range(bayindex_count(sh->index, state)));
+}
+
+/**
+* @brief Reserves a free bay
+* @param airport* Pointer to structure to work on
+* @param bay_shard* Zone of the bay
+* @param int Number of the bay
+*
+* The caller has to hold the lock of the zone.
+*
+* */
+static void reserve_bay(airport *ap, bay_shard *sh, int bay_nr) {
+    ap->bays[bay_nr] = bay_init();
+    set_bay_state(sh, bay_nr, BAY_RESERVED);
+    trace_event(TRACE_RESERVE, bay_nr, -1, NULL);
+}
+
+/**
+* @brief Unparks the plane of an occupied bay
+* @param airport* Pointer to structure to work on
+* @param bay_shard* Zone of the bay
+* @param int Number of the bay
+* @return The unparked plane
+*
+* The caller has to hold the lock of the zone. The bay stays reserved.
+*
+* */
+static plane *unpark_bay(airport *ap, bay_shard *sh, int bay_nr) {
+    stats_record(STATS_TURNAROUND, bay_get_occupation_time(ap->bays[bay_nr]));
+    plane *p = bay_unpark_plane(ap->bays[bay_nr]);
+    set_bay_state(sh, bay_nr, BAY_RESERVED);
+    publish_bay(ap, sh, bay_nr);
+    trace_event(TRACE_UNPARK, bay_nr, -1, NULL);
+    return p;
+}
+
+/**
+* @brief Reserves a random free bay for a plane, which is about to land
+* @param airport* Pointer to structure to work on
+* @return The number of the reserved bay
+*
+* The caller has to hold a unit of the empty-queue. The reserved bay stays without a plane until
+* airport_park_plane() is called, and is not handed out to other planes in the meantime.
+*
+* */
+static int reserve_free_bay(airport *ap) {
+    bay_shard *sh = lock_shard_with(ap, BAY_FREE);
+    int bay_nr = get_random_bay_nr(sh, BAY_FREE);
+    reserve_bay(ap, sh, bay_nr);
+    lockstat_unlock(&sh->lock);
+    return bay_nr;
+}
+
+#ifdef AIRPORT_SINGLE_RUNWAY
+
+/**
+* @brief Takes the runway
+* @param airport* Pointer to structure to work on
+* @return The number of the runway, always 0
+*
+* The caller has to hold the only unit of the runways-queue, so there is nothing left to claim.
+*
+* */
+static inline int claim_runway(airport *ap) {
+    ap->runway_list[0].acquired = current_timestamp();
+    trace_event(TRACE_ACQUIRE, 0, -1, NULL);
+    return 0;
+}
+
+/**
+* @brief Frees a runway taken with claim_runway()
+* @param airport* Pointer to structure to work on
+* @param int Number of the runway
+*
+* */
+static inline void free_runway(airport *ap, int rw) {
+    /* the queue hands the runway to the plane, which waited longest, a plain mutex would let any plane barge in */
+    admission_post(&ap->runways);
+}
+
+#else
+
+/**
+* @brief Takes a free runway
+* @param airport* Pointer to structure to work on
+* @return The number of the runway
+*
+* The caller has to hold a unit of the runways-queue, so that there is a free runway. The lowest free runway is
+* claimed by atomically setting its bit in the runway mask, so no lock is needed.
+*
+* */
+static int claim_runway(airport *ap) {
+    int words = (ap->num_runways + RUNWAYS_PER_WORD - 1) / RUNWAYS_PER_WORD;
+    while (1) {
+        for (int i = 0; i < words; ++i) {
+            uint64_t w = __atomic_load_n(&ap->runway_mask[i], __ATOMIC_RELAXED);
+            while (~w != 0) {
+                int bit = __builtin_ctzll(~w);
+                int rw = i * RUNWAYS_PER_WORD + bit;
+                if (rw >= ap->num_runways)
+                    break;
+                if (__atomic_compare_exchange_n(&ap->runway_mask[i], &w, w | (1ULL << bit), false,
+                                                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                    ap->runway_list[rw].acquired = current_timestamp();
+                    trace_event(TRACE_ACQUIRE, rw, -1, NULL);
+                    return rw;
+                }
+                /* w has been reloaded by the failed exchange */
+            }
+        }
+    }
+}
+
+/**
+* @brief Frees a runway taken with claim_runway()
+* @param airport* Pointer to structure to work on
+* @param int Number of the runway
+*
+* Clears the runway's bit and returns the unit to the runways-queue.
+*
+* */
+static inline void free_runway(airport *ap, int rw) {
+    __atomic_and_fetch(&ap->runway_mask[rw / RUNWAYS_PER_WORD], ~(1ULL << (rw % RUNWAYS_PER_WORD)), __ATOMIC_RELEASE);
+    admission_post(&ap->runways);
+}
+
+#endif
+
+airport *airport_init(char *name, int num_bays, int num_runways) {
+    airport *ap = (airport *) malloc(sizeof(airport));
+    ap->num_bays = num_bays;
+#ifdef AIRPORT_SINGLE_RUNWAY
+    num_runways = 1;
+#endif
+    ap->num_runways = num_runways;
+    /* one zone per runway, but no empty zones */
+    ap->num_shards = num_runways < num_bays ? num_runways : num_bays;
+
+    /* initialize the queues */
+    admission_init(&(ap->empty), num_bays, "bay_queue");
+    admission_init(&(ap->full), 0, "plane_queue");
+    admission_init(&(ap->runways), num_runways, "runway_queue");
+
+    /* all runways are free */
+    ap->runway_list = (runway *) calloc(num_runways, sizeof(runway));
+#ifndef AIRPORT_SINGLE_RUNWAY
+    ap->runway_mask = (uint64_t *) calloc((num_runways + RUNWAYS_PER_WORD - 1) / RUNWAYS_PER_WORD, sizeof(uint64_t));
+#endif
+
+    ap->bays = (bay **) malloc(num_bays * sizeof(bay *));
+    /* every bay holds at most one plane, so the pools never grow */
+    bay_pool_reserve(num_bays);
+    plane_pool_reserve(num_bays);
+
+    /* split the bays into zones of consecutive bays */
+    ap->shard_size = (num_bays + ap->num_shards - 1) / ap->num_shards;
+    ap->shards = (bay_shard *) malloc(ap->num_shards * sizeof(bay_shard));
+    for (int i = 0; i < ap->num_shards; ++i) {
+        bay_shard *sh = &ap->shards[i];
+        int first = i * ap->shard_size;
+        int size = first >= num_bays ? 0 : (num_bays - first < ap->shard_size ? num_bays - first : ap->shard_size);
+        lockstat_init(&sh->lock, "bay_zone");
+        sh->index = bayindex_init(size);
+        sh->first = first;
+        sh->num_free = size;
+        sh->num_occupied = 0;
+        sh->seq = 0;
+    }
+    ap->views = (bay_view *) calloc(num_bays, sizeof(bay_view));
+
+    /* copy name of airport, so that we are responsible for the memory management */
+    ap->name = malloc(strlen(name) + 1);
+    sprintf(ap->name, "%s", name);
+
+    /* empty all bays */
+    for (int i = 0; i < num_bays; ++i) {
+        ap->bays[i] = NULL;
+    }
+    return ap;
+}
+
+int airport_reserve_bay(airport *ap) {
+    if (!admission_trywait(&ap->empty))
+        return -1;
+    return reserve_free_bay(ap);
+}
+
+/**
+* @brief Parks a plane in a reserved bay
+* @param airport* Pointer to structure to work on
+* @param int Number of the reserved bay
+* @param plane* The plane to park
+* @param int Number of the runway the plane landed on
+* @param time_t Timestamp the plane was parked at
+*
+* */
+static void park_plane_at(airport *ap, int bay_nr, plane *p, int runway, time_t parked_at) {
+    bay_shard *sh = shard_of(ap, bay_nr);
+    lockstat_lock(&sh->lock);
+    bay_park_plane_at(ap->bays[bay_nr], p, runway, parked_at);
+    set_bay_state(sh, bay_nr, BAY_OCCUPIED);
+    publish_bay(ap, sh, bay_nr);
+    trace_event(TRACE_PARK, bay_nr, runway, plane_get_name(p));
+    lockstat_unlock(&sh->lock);
+    admission_post(&ap->full);
+}
+
+void airport_park_plane(airport *ap, int bay_nr, plane *p, int runway) {
+    park_plane_at(ap, bay_nr, p, runway, current_timestamp());
+}
+
+bool airport_claim_plane(airport *ap) {
+    return admission_trywait(&ap->full);
+}
+
+void airport_unclaim_plane(airport *ap) {
+    admission_post(&ap->full);
+}
+
+plane *airport_unpark_plane(airport *ap, int *bay_nr) {
+    bay_shard *sh = lock_shard_with(ap, BAY_OCCUPIED);
+    *bay_nr = get_random_bay_nr(sh, BAY_OCCUPIED);
+    plane *p = unpark_bay(ap, sh, *bay_nr);
+    lockstat_unlock(&sh->lock);
+    return p;
+}
+
+void airport_release_bay(airport *ap, int bay_nr) {
+    bay_shard *sh = shard_of(ap, bay_nr);
+    lockstat_lock(&sh->lock);
+    bay_destroy(ap->bays[bay_nr]);
+    ap->bays[bay_nr] = NULL;
+    set_bay_state(sh, bay_nr, BAY_FREE);
+    trace_event(TRACE_RELEASE, bay_nr, -1, NULL);
+    lockstat_unlock(&sh->lock);
+    admission_post(&ap->empty);
+}
+
+/**
+* @brief Gets one of the queues of an airport
+* @param airport* Pointer to structure to work on
+* @param int AIRPORT_BAYS, AIRPORT_PLANES or AIRPORT_RUNWAYS
+* @return The queue
+*
+* */
+static admission *queue_of(airport *ap, int queue) {
+    switch (queue) {
+        case AIRPORT_BAYS:
+            return &ap->empty;
+        case AIRPORT_PLANES:
+            return &ap->full;
+        default:
+            return &ap->runways;
+    }
+}
+
+bool airport_enqueue(airport *ap, int queue, admission_waiter *w) {
+    return admission_enqueue(queue_of(ap, queue), w);
+}
+
+bool airport_expire(airport *ap, int queue, admission_waiter *w, time_t now) {
+    return admission_expire(queue_of(ap, queue), w, now);
+}
+
+int airport_take_bay(airport *ap) {
+    return reserve_free_bay(ap);
+}
+
+int airport_take_runway(airport *ap) {
+    return claim_runway(ap);
+}
+
+bool airport_reserve_bay_nr(airport *ap, int bay_nr) {
+    if (bay_nr < 0 || bay_nr >= ap->num_bays)
+        return false;
+    bay_shard *sh = shard_of(ap, bay_nr);
+    lockstat_lock(&sh->lock);
+    bool ok = bayindex_get(sh->index, bay_nr - sh->first) == BAY_FREE && admission_trywait(&ap->empty);
+    if (ok)
+        reserve_bay(ap, sh, bay_nr);
+    lockstat_unlock(&sh->lock);
+    return ok;
+}
+
+plane *airport_unpark_plane_nr(airport *ap, int bay_nr) {
+    if (bay_nr < 0 || bay_nr >= ap->num_bays)
+        return NULL;
+    bay_shard *sh = shard_of(ap, bay_nr);
+    lockstat_lock(&sh->lock);
+    plane *p = NULL;
+    if (bayindex_get(sh->index, bay_nr - sh->first) == BAY_OCCUPIED && admission_trywait(&ap->full))
+        p = unpark_bay(ap, sh, bay_nr);
+    lockstat_unlock(&sh->lock);
+    return p;
+}
+
+int airport_acquire_runway(airport *ap) {
+    if (!admission_trywait(&ap->runways))
+        return -1;
+    return claim_runway(ap);
+}
+
+void airport_release_runway(airport *ap, int rw) {
+    runway *r = &ap->runway_list[rw];
+    /* traced before the runway is free, so that the next holder's event comes later */
+    trace_event(TRACE_FREE, rw, -1, NULL);
+    /* only the holder of the runway writes its statistics */
+    __atomic_add_fetch(&r->busy_time, current_timestamp() - r->acquired, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&r->operations, 1, __ATOMIC_RELAXED);
+    free_runway(ap, rw);
+}
+
+bool airport_acquire_runway_nr(airport *ap, int rw) {
+    if (rw < 0 || rw >= ap->num_runways || !admission_trywait(&ap->runways))
+        return false;
+#ifdef AIRPORT_SINGLE_RUNWAY
+    claim_runway(ap);
+    return true;
+#else
+    uint64_t *word = &ap->runway_mask[rw / RUNWAYS_PER_WORD];
+    uint64_t bit = 1ULL << (rw % RUNWAYS_PER_WORD);
+    uint64_t w = __atomic_load_n(word, __ATOMIC_RELAXED);
+    do {
+        if (w & bit) {
+            admission_post(&ap->runways);
+            return false;
+        }
+    } while (!__atomic_compare_exchange_n(word, &w, w | bit, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+    ap->runway_list[rw].acquired = current_timestamp();
+    trace_event(TRACE_ACQUIRE, rw, -1, NULL);
+    return true;
+#endif
+}
+
+bool airport_restore_plane(airport *ap, int bay_nr, plane *p, int runway, time_t parked_at) {
+    if (!airport_reserve_bay_nr(ap, bay_nr))
+        return false;
+    park_plane_at(ap, bay_nr, p, runway, parked_at);
+    return true;
+}
+
+bool airport_get_parked_plane(airport *ap, int bay_nr, char *name, time_t *parked_at, int *runway) {
+    bay_shard *sh = shard_of(ap, bay_nr);
+    lockstat_lock(&sh->lock);
+    bay *b = ap->bays[bay_nr];
+    bool parked = b != NULL && bay_get_plane(b) != NULL;
+    if (parked) {
+        strncpy(name, plane_get_name(bay_get_plane(b)), 7);
+        name[7] = '\0';
+        *parked_at = bay_get_parking_time(b);
+        *runway = bay_get_runway(b);
+    }
+    lockstat_unlock(&sh->lock);
+    return parked;
+}
+
+void airport_set_runway_stats(airport *ap, int rw, unsigned long operations, time_t busy_time) {
+    __atomic_store_n(&ap->runway_list[rw].operations, operations, __ATOMIC_RELAXED);
+    __atomic_store_n(&ap->runway_list[rw].busy_time, busy_time, __ATOMIC_RELAXED);
+}
+
+int airport_get_num_bays(airport *ap) {
+    return ap->num_bays;
+}
+
+int airport_get_num_runways(airport *ap) {
+    return ap->num_runways;
+}
+
+void airport_get_runway_stats(airport *ap, int rw, unsigned long *operations, time_t *busy_time) {
+    *operations = __atomic_load_n(&ap->runway_list[rw].operations, __ATOMIC_RELAXED);
+    *busy_time = __atomic_load_n(&ap->runway_list[rw].busy_time, __ATOMIC_RELAXED);
+}
+
+time_t airport_get_bay_time(airport *ap, int bay_nr) {
+    bay_shard *sh = shard_of(ap, bay_nr);
+    lockstat_lock(&sh->lock);
+    time_t t = bay_get_occupation_time(ap->bays[bay_nr]);
+    lockstat_unlock(&sh->lock);
+    return t;
+}
+
+void airport_land_plane(airport *ap) {
+    time_t queued;
+    struct timespec ts;
+    timesource_deadline(&ts, 5000);
+
+    /* A plane queues for a maximum of 5 seconds, or until the application shuts down */
+    if (admission_wait(&ap->empty, &ts, &queued)) {
+        plane *p = plane_init();
+        int bay_nr = reserve_free_bay(ap);
+        stats_record(STATS_BAY_WAIT, queued);
+
+        if (!admission_wait(&ap->runways, &ts, &queued)) {
+            /* no runway got free in time, so the plane is turned away and the bay is free again */
+            if (!cancel_requested()) {
+                logger_event(LOGGER_TURNED_AWAY, plane_get_name(p), bay_nr, -1, 0);
+                stats_count(STATS_TIMEOUTS);
+            }
+            plane_destroy(p);
+            airport_release_bay(ap, bay_nr);
+            return;
+        }
+        int rw = claim_runway(ap);
+        stats_record(STATS_RUNWAY_WAIT, queued);
+
+        logger_event(LOGGER_LANDING, plane_get_name(p), bay_nr, rw, 0);
+        /* landing time is 2 seconds, on shutdown the plane is parked at once */
+        cancel_sleep(2000);
+        airport_release_runway(ap, rw);
+
+        airport_park_plane(ap, bay_nr, p, rw);
+        logger_event(LOGGER_PARKED, plane_get_name(p), bay_nr, rw, 0);
+        stats_count(STATS_LANDINGS);
+        if (airport_is_full(ap)) {
+            logger_event(LOGGER_FULL, NULL, -1, -1, 0);
+        }
+    } else if (!cancel_requested()) {
+        stats_count(STATS_TIMEOUTS);
+    }
+}
+
+void airport_takeoff_plane(airport *ap) {
+    time_t queued;
+    struct timespec ts;
+    timesource_deadline(&ts, 5000);
+
+    /* A plane queues for a maximum of 5 seconds, or until the application shuts down */
+    if (admission_wait(&ap->full, &ts, &queued)) {
+        stats_record(STATS_PLANE_WAIT, queued);
+        if (!admission_wait(&ap->runways, &ts, &queued)) {
+            /* no runway got free in time, so the plane stays in its bay */
+            if (!cancel_requested()) {
+                logger_event(LOGGER_STAYED, NULL, -1, -1, 0);
+                stats_count(STATS_TIMEOUTS);
+            }
+            airport_unclaim_plane(ap);
+            return;
+        }
+        int rw = claim_runway(ap);
+        stats_record(STATS_RUNWAY_WAIT, queued);
+
+        int bay_nr;
+        plane *p = airport_unpark_plane(ap, &bay_nr);
+        if (logger_enabled(LOGGER_TAKEOFF))
+            logger_event(LOGGER_TAKEOFF, plane_get_name(p), bay_nr, rw, airport_get_bay_time(ap, bay_nr));
+
+        /* take-off time is 2 seconds, on shutdown the plane is gone at once */
+        cancel_sleep(2000);
+        airport_release_runway(ap, rw);
+
+        logger_event(LOGGER_DEPARTED, plane_get_name(p), bay_nr, rw, 0);
+        plane_destroy(p);
+        airport_release_bay(ap, bay_nr);
+        stats_count(STATS_TAKEOFFS);
+        if (airport_is_empty(ap)) {
+            logger_event(LOGGER_EMPTY, NULL, -1, -1, 0);
+        }
+    } else if (!cancel_requested()) {
+        stats_count(STATS_TIMEOUTS);
+    }
+}
+
+void airport_write(airport *ap, strbuf *sb) {
+    strbuf_printf(sb, "Airport \'%s\' state: \n", ap->name);
+    /* the views are read without locks, so printing never stalls landings and take-offs */
+    bay_view *copy = malloc(ap->shard_size * sizeof(bay_view));
+    time_t now = current_timestamp();
+    for (int z = 0; z < ap->num_shards; ++z) {
+        bay_shard *sh = &ap->shards[z];
+        int size = sh->first + ap->shard_size < ap->num_bays ? ap->shard_size : ap->num_bays - sh->first;
+        read_zone(ap, sh, size, copy);
+        for (int i = 0; i < size; ++i) {
+            if (copy[i].name != 0) {
+                char name[sizeof(uint64_t) + 1] = {0};
+                memcpy(name, &copy[i].name, sizeof(uint64_t));
+                strbuf_printf(sb, "%d: %s (has parked for %.2f seconds, came on runway %d)\n", sh->first + i, name,
+                              (now - copy[i].parked_at) / 1000.0f, copy[i].runway);
+            } else {
+                strbuf_printf(sb, "%d: empty \n", sh->first + i);
+            }
+        }
+        strbuf_flush(sb);
+    }
+    free(copy);
+    for (int i = 0; i < ap->num_runways; ++i) {
+        unsigned long operations;
+        time_t busy_time;
+        airport_get_runway_stats(ap, i, &operations, &busy_time);
+        strbuf_printf(sb, "Runway %d: %lu landings and take-offs, in use for %.2f seconds\n", i, operations,
+                      busy_time / 1000.0f);
+    }
+    strbuf_flush(sb);
+}
+
+void airport_print(airport *ap, FILE *out) {
+    strbuf *sb = strbuf_init_stream(out);
+    airport_write(ap, sb);
+    strbuf_destroy(sb);
+}
+
+char *airport_to_string(airport *ap) {
+    strbuf *sb = strbuf_init();
+    airport_write(ap, sb);
+    return strbuf_release(sb);
+}
+
+void airport_destroy(airport *ap) {
+    /* free the airport's name */
+    free(ap->name);
+    /* free the landing bays */
+    for (int i = 0; i < ap->num_bays; ++i) {
+        if (ap->bays[i] != NULL) {
+            bay_destroy(ap->bays[i]);
+        }
+    }
+    free(ap->bays);
+    bay_pool_release();
+    plane_pool_release();
+    for (int i = 0; i < ap->num_shards; ++i) {
+        bayindex_destroy(ap->shards[i].index);
+        lockstat_destroy(&ap->shards[i].lock);
+    }
+    free(ap->shards);
+    free(ap->views);
+    /* destroy the queues */
+    free(ap->runway_list);
+#ifndef AIRPORT_SINGLE_RUNWAY
+    free(ap->runway_mask);
+#endif
+    admission_destroy(&ap->runways);
+    admission_destroy(&ap->full);
+    admission_destroy(&ap->empty);
+    /* free airport structure */
+    free(ap);
+}
+
+
+
+
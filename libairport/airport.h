@@ -0,0 +1,380 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file airport.h
+ * @author Lukas Elsner
+ * @date 01-09-2014
+ * @brief Header containing the public accessible airport methods.
+ *
+ * The airport is the main data structure of this application. It provides the parking bays and thread safe
+ * take-off and landing functionality.
+ *
+ * Free bays, parked planes and free runways are handed out by fair admission queues, in the order the planes asked for
+ * them.
+ *
+ * The library is built in two variants. Compiled with AIRPORT_SINGLE_RUNWAY, every airport has exactly one runway,
+ * which needs no bookkeeping besides its queue. Otherwise, a mask of the runways in use tells which runway is free.
+ *
+ */
+
+#ifndef AIRPORT_H
+#define AIRPORT_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+#include "admission.h"
+#include "plane.h"
+#include "strbuf.h"
+
+/**
+* @brief Forward declaration for airport
+*
+* */
+typedef struct airport airport;
+
+/**
+* @brief Queues of an airport, which tasks wait in with airport_enqueue()
+*
+* */
+enum {
+    AIRPORT_BAYS, /**< Free bays, for landing planes. */
+    AIRPORT_PLANES, /**< Parked planes, for take-offs. */
+    AIRPORT_RUNWAYS /**< Free runways. */
+};
+
+/**
+* @brief Default number of parking bays of an airport
+*
+* */
+#define AIRPORT_DEFAULT_BAYS 100
+
+/**
+* @brief Default number of runways of an airport
+*
+* */
+#define AIRPORT_DEFAULT_RUNWAYS 10
+
+/**
+ * @brief constructor for airport
+ * @param char* The name of the airport
+ * @param int Number of parking bays, at least one
+ * @param int Number of runways, at least one, ignored with AIRPORT_SINGLE_RUNWAY
+ * @return A pointer to the airport structure, representing the created object
+ *
+ * The bays are split into one zone per runway, each with its own lock.
+ * After using this structure, it must be freed with airport_destroy(airport *)
+ *
+ * */
+ airport *airport_init(char *, int, int);
+
+/**
+* @brief Lets a plane land on the airport
+* @param airport* Pointer to structure to work on
+*
+* This method creates a plane and parks it in a randomly chosen empty parking bay.
+* It is thread safe.
+* When the airport is full, it queues for a free slot and then for a runway, for a maximum of 5 seconds together.
+* Planes are served in arrival order. If the time runs out, it returns without any side effects.
+* When cancellation is requested, it stops queueing at once, and a plane, which is landing, is parked at once.
+*
+* */
+void airport_land_plane(airport *);
+
+/**
+ * @brief Lets a plane take off from the airport
+ * @param airport* Pointer to structure to work on
+ *
+ * This method chooses a random plane from the parking bay to take off.
+ * It is thread safe.
+ * When the airport is empty, it queues for a plane and then for a runway, for a maximum of 5 seconds together.
+ * Take-offs are served in arrival order. If the time runs out, it returns without any side effects.
+ * When cancellation is requested, it stops queueing at once, and a plane, which is taking off, is gone at once.
+ *
+ * */
+void airport_takeoff_plane(airport *);
+
+/**
+ * @brief Reserves a random free bay for a landing plane without blocking
+ * @param airport* Pointer to structure to work on
+ * @return The number of the reserved bay, or -1 if the airport is full
+ *
+ * The bay stays reserved until a plane is parked in it with airport_park_plane(), or it is given back with
+ * airport_release_bay(). It is thread safe.
+ *
+ * */
+int airport_reserve_bay(airport *);
+
+/**
+ * @brief Parks a plane in a reserved bay
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the bay, which was reserved with airport_reserve_bay()
+ * @param plane* The plane to park
+ * @param int Number of the runway the plane landed on
+ *
+ * After parking, the plane is available for airport_claim_plane(). It is thread safe.
+ *
+ * */
+void airport_park_plane(airport *, int, plane *, int);
+
+/**
+ * @brief Claims one of the parked planes for take-off without blocking
+ * @param airport* Pointer to structure to work on
+ * @return True, if a plane was claimed, false if the airport is empty
+ *
+ * A claim guarantees, that the next call to airport_unpark_plane() finds a plane. It can be given back with
+ * airport_unclaim_plane(). It is thread safe.
+ *
+ * */
+bool airport_claim_plane(airport *);
+
+/**
+ * @brief Gives back a claim taken with airport_claim_plane()
+ * @param airport* Pointer to structure to work on
+ *
+ * */
+void airport_unclaim_plane(airport *);
+
+/**
+ * @brief Unparks a random plane for take-off
+ * @param airport* Pointer to structure to work on
+ * @param int* Is set to the number of the bay the plane was parked in
+ * @return The unparked plane, which is owned by the caller from now on
+ *
+ * The caller must hold a claim from airport_claim_plane(). The bay stays reserved until airport_release_bay() is called.
+ * It is thread safe.
+ *
+ * */
+plane *airport_unpark_plane(airport *, int *);
+
+/**
+ * @brief Frees a reserved bay
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the bay, which does not contain a plane anymore
+ *
+ * The bay is available for airport_reserve_bay() again. It is thread safe.
+ *
+ * */
+void airport_release_bay(airport *, int);
+
+/**
+ * @brief Acquires a runway without blocking
+ * @param airport* Pointer to structure to work on
+ * @return The number of the acquired runway, or -1 if all runways are in use
+ *
+ * The returned runway is used by no other plane until it is released. It is thread safe.
+ *
+ * */
+int airport_acquire_runway(airport *);
+
+/**
+ * @brief Releases a runway acquired with airport_acquire_runway()
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the runway
+ *
+ * */
+void airport_release_runway(airport *, int);
+
+/**
+ * @brief Gets in line for a free bay, a parked plane or a free runway without blocking
+ * @param airport* Pointer to structure to work on
+ * @param int The queue, AIRPORT_BAYS, AIRPORT_PLANES or AIRPORT_RUNWAYS
+ * @param admission_waiter* Waiter of the task, see admission_enqueue()
+ * @return True, if the caller got a unit of the queue at once, false if the waiter is called back later
+ *
+ * A unit of AIRPORT_PLANES is a claim as taken by airport_claim_plane(). A unit of AIRPORT_BAYS is turned into a bay
+ * with airport_take_bay(), a unit of AIRPORT_RUNWAYS into a runway with airport_take_runway(). It is thread safe.
+ *
+ * */
+bool airport_enqueue(airport *, int, admission_waiter *);
+
+/**
+ * @brief Leaves a queue entered with airport_enqueue(), when the deadline of the waiter has passed
+ * @param airport* Pointer to structure to work on
+ * @param int The queue
+ * @param admission_waiter* Waiter of the task
+ * @param time_t Current time
+ * @return True, if the waiter was still queued and will not be called back, false otherwise
+ *
+ * See admission_expire().
+ *
+ * */
+bool airport_expire(airport *, int, admission_waiter *, time_t);
+
+/**
+ * @brief Reserves a random free bay with a unit of the AIRPORT_BAYS queue
+ * @param airport* Pointer to structure to work on
+ * @return The number of the reserved bay
+ *
+ * Like airport_reserve_bay(), but the caller already holds the unit. It is thread safe.
+ *
+ * */
+int airport_take_bay(airport *);
+
+/**
+ * @brief Acquires a free runway with a unit of the AIRPORT_RUNWAYS queue
+ * @param airport* Pointer to structure to work on
+ * @return The number of the acquired runway
+ *
+ * Like airport_acquire_runway(), but the caller already holds the unit. It is thread safe.
+ *
+ * */
+int airport_take_runway(airport *);
+
+/**
+ * @brief Reserves a given bay without blocking
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the bay
+ * @return True, if the bay was free and is reserved now, false otherwise
+ *
+ * Like airport_reserve_bay(), but the caller chooses the bay, to replay a trace. It is thread safe.
+ *
+ * */
+bool airport_reserve_bay_nr(airport *, int);
+
+/**
+ * @brief Unparks the plane of a given bay without blocking
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the bay
+ * @return The unparked plane, which is owned by the caller from now on, or NULL if the bay holds no plane
+ *
+ * Like airport_claim_plane() followed by airport_unpark_plane(), but the caller chooses the bay, to replay a trace.
+ * It is thread safe.
+ *
+ * */
+plane *airport_unpark_plane_nr(airport *, int);
+
+/**
+ * @brief Acquires a given runway without blocking
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the runway
+ * @return True, if the runway was free and is acquired now, false otherwise
+ *
+ * Like airport_acquire_runway(), but the caller chooses the runway, to replay a trace. It is thread safe.
+ *
+ * */
+bool airport_acquire_runway_nr(airport *, int);
+
+/**
+ * @brief Parks a plane in a given free bay, as if it had been parked at the given time
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the bay
+ * @param plane* The plane to park
+ * @param int Number of the runway the plane landed on
+ * @param time_t Timestamp the plane was parked at
+ * @return True, if the bay was free and the plane is parked, false otherwise
+ *
+ * Used to restore a checkpoint. It is thread safe.
+ *
+ * */
+bool airport_restore_plane(airport *, int, plane *, int, time_t);
+
+/**
+ * @brief Gets the plane parked in a bay
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the bay
+ * @param char* Receives the name of the plane, must hold 8 characters
+ * @param time_t* Receives the timestamp the plane was parked at
+ * @param int* Receives the number of the runway the plane landed on
+ * @return True, if a plane is parked in the bay, false otherwise, then nothing is received
+ *
+ * It is thread safe.
+ *
+ * */
+bool airport_get_parked_plane(airport *, int, char *, time_t *, int *);
+
+/**
+ * @brief Sets the usage of a runway
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the runway
+ * @param unsigned-long Number of finished landings and take-offs on the runway
+ * @param time_t Time in milliseconds the runway was in use by finished operations
+ *
+ * Used to restore a checkpoint, while the runway is not in use.
+ *
+ * */
+void airport_set_runway_stats(airport *, int, unsigned long, time_t);
+
+/**
+ * @brief Gets the number of parking bays
+ * @param airport* Pointer to structure to work on
+ * @return The number of parking bays
+ *
+ * */
+int airport_get_num_bays(airport *);
+
+/**
+ * @brief Gets the number of runways
+ * @param airport* Pointer to structure to work on
+ * @return The number of runways
+ *
+ * */
+int airport_get_num_runways(airport *);
+
+/**
+ * @brief Gets the usage of a runway
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the runway
+ * @param unsigned-long* Is set to the number of finished landings and take-offs on the runway
+ * @param time_t* Is set to the time in milliseconds the runway was in use by finished operations
+ *
+ * It is thread safe and does not block.
+ *
+ * */
+void airport_get_runway_stats(airport *, int, unsigned long *, time_t *);
+
+/**
+ * @brief Gets the occupation time of a bay
+ * @param airport* Pointer to structure to work on
+ * @param int Number of the bay
+ * @return The occupation time in milliseconds, see bay_get_occupation_time()
+ *
+ * */
+time_t airport_get_bay_time(airport *, int);
+
+/**
+ * @brief Method for getting a string representation of the current airport state.
+ * @param airport* Pointer to structure to work on
+ * @return A pointer to a string representation of passed structure. Must be freed by caller.
+ *
+ * This is a thread safe call to return the current airport state in a human readable form. It does not block
+ * landings and take-offs.
+ *
+ * */
+char *airport_to_string(airport *);
+
+/**
+ * @brief Appends the current airport state to a string buffer
+ * @param airport* Pointer to structure to work on
+ * @param strbuf* Buffer to append to
+ *
+ * Writes the same text as airport_to_string(), in time linear in the number of bays. If the buffer streams to a file,
+ * the text of every zone of bays is written out as soon as it is formatted. No lock is taken: every zone of bays is
+ * read from a snapshot, which is consistent within the zone.
+ *
+ * */
+void airport_write(airport *, strbuf *);
+
+/**
+ * @brief Prints the current airport state
+ * @param airport* Pointer to structure to work on
+ * @param FILE* Stream to print to
+ *
+ * Streams the text of airport_write() to the file without building it in memory first.
+ *
+ * */
+void airport_print(airport *, FILE *);
+
+/**
+ * @brief Destructor for airport
+ * @param airport* Pointer to structure to be freed
+ *
+ * */
+void airport_destroy(airport *);
+
+#endif /* AIRPORT_H */
@@ -0,0 +1,211 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file arrival.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the arrival processes.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arrival.h"
+#include "tools.h"
+
+/**
+ * @brief Maximum length of a line of a file of an empirical process
+ *
+ * */
+#define ARRIVAL_LINE_SIZE 256
+
+/**
+ * @brief Prefix of the rate of a poisson process
+ *
+ * */
+static const char poisson_prefix[] = "poisson:";
+
+/**
+ * @brief Prefix of the file of an empirical process
+ *
+ * */
+static const char empirical_prefix[] = "empirical:";
+
+/**
+ * @brief Parses the rate of a poisson process
+ * @param char* Name of the process, starting with poisson_prefix
+ * @param double* Receives the operations per simulated hour
+ * @return True, if the rate is a positive number, false otherwise
+ *
+ * */
+static bool parse_rate(const char *name, double *rate) {
+    const char *value = name + strlen(poisson_prefix);
+    char *end;
+    double r = strtod(value, &end);
+    if (end == value || *end != '\0' || !(r > 0) || r > 1e9)
+        return false;
+    *rate = r;
+    return true;
+}
+
+/**
+ * @brief Reads the times of an empirical process
+ * @param arrival* Pointer to structure to work on
+ * @param char* Path of the file
+ * @param double Factor every time is stretched by
+ * @return True, if the file has at least one time with a positive weight and no invalid line, false otherwise
+ *
+ * Invalid lines are reported on stderr.
+ *
+ * */
+static bool load_gaps(arrival *a, const char *path, double stretch) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "%s: cannot open arrival times\n", path);
+        return false;
+    }
+    int size = 64;
+    a->gaps = (double *) malloc(size * sizeof(double));
+    a->weights = (double *) malloc(size * sizeof(double));
+    double total = 0;
+    char line[ARRIVAL_LINE_SIZE];
+    bool ok = true;
+    for (int nr = 1; fgets(line, sizeof(line), f) != NULL; ++nr) {
+        char *s = line;
+        while (*s == ' ' || *s == '\t')
+            ++s;
+        if (*s == '\0' || *s == '\n' || *s == '#')
+            continue;
+        char *end;
+        double seconds = strtod(s, &end);
+        double weight = 1;
+        if (end != s && (*end == ' ' || *end == '\t'))
+            weight = strtod(end, &end);
+        while (*end == ' ' || *end == '\t' || *end == '\n' || *end == '\r')
+            ++end;
+        if (end == s || *end != '\0' || !(seconds >= 0) || !(weight >= 0)) {
+            fprintf(stderr, "%s:%d: invalid arrival time\n", path, nr);
+            ok = false;
+            continue;
+        }
+        if (a->num_gaps == size) {
+            size *= 2;
+            a->gaps = (double *) realloc(a->gaps, size * sizeof(double));
+            a->weights = (double *) realloc(a->weights, size * sizeof(double));
+        }
+        total += weight;
+        a->gaps[a->num_gaps] = seconds * 1000 * stretch;
+        a->weights[a->num_gaps] = total;
+        a->num_gaps++;
+    }
+    fclose(f);
+    if (ok && !(total > 0)) {
+        fprintf(stderr, "%s: no arrival times\n", path);
+        ok = false;
+    }
+    return ok;
+}
+
+/**
+ * @brief Rounds a time to whole milliseconds
+ * @param double The time in milliseconds
+ * @return The rounded time
+ *
+ * */
+static inline long long round_ms(double ms) {
+    return (long long) (ms + 0.5);
+}
+
+int arrival_parse(const char *name) {
+    double rate;
+    if (!strcmp(name, "tick"))
+        return ARRIVAL_TICK;
+    if (!strcmp(name, "poisson"))
+        return ARRIVAL_POISSON;
+    if (!strncmp(name, poisson_prefix, strlen(poisson_prefix)))
+        return parse_rate(name, &rate) ? ARRIVAL_POISSON : -1;
+    if (!strncmp(name, empirical_prefix, strlen(empirical_prefix)) && name[strlen(empirical_prefix)] != '\0')
+        return ARRIVAL_EMPIRICAL;
+    return -1;
+}
+
+bool arrival_init(arrival *a, const char *name, int prob, int actors) {
+    a->process = arrival_parse(name);
+    a->prob = prob;
+    a->mean = ARRIVAL_TICK_MS * 100.0 / (prob > 0 ? prob : 1);
+    a->gaps = NULL;
+    a->weights = NULL;
+    a->num_gaps = 0;
+    if (actors < 1)
+        actors = 1;
+
+    double rate;
+    switch (a->process) {
+        case ARRIVAL_TICK:
+            return true;
+        case ARRIVAL_POISSON:
+            /* all actors of the kind share the rate, so each one runs that much slower */
+            if (strcmp(name, "poisson") != 0 && parse_rate(name, &rate))
+                a->mean = 3600000.0 * actors / rate;
+            return true;
+        case ARRIVAL_EMPIRICAL:
+            return load_gaps(a, name + strlen(empirical_prefix), actors);
+    }
+    return false;
+}
+
+long long arrival_first(const arrival *a) {
+    if (a->process == ARRIVAL_TICK)
+        return 0;
+    return round_ms(rng_double() * arrival_next(a));
+}
+
+long long arrival_next(const arrival *a) {
+    switch (a->process) {
+        case ARRIVAL_POISSON:
+            /* inverse transform sampling, 1 - u is never 0 */
+            return round_ms(-a->mean * log(1 - rng_double()));
+        case ARRIVAL_EMPIRICAL: {
+            /* find the first time, whose summed up weight exceeds a uniform draw */
+            double u = rng_double() * a->weights[a->num_gaps - 1];
+            int lo = 0, hi = a->num_gaps - 1;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (a->weights[mid] > u)
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            return round_ms(a->gaps[lo]);
+        }
+        default:
+            return ARRIVAL_TICK_MS;
+    }
+}
+
+long long arrival_next_at(const arrival *a, long long last, long long now) {
+    if (a->process == ARRIVAL_TICK)
+        return now + ARRIVAL_TICK_MS;
+    return last + arrival_next(a);
+}
+
+bool arrival_fires(const arrival *a) {
+    if (a->process == ARRIVAL_TICK)
+        return prob_bool(a->prob);
+    return true;
+}
+
+void arrival_destroy(arrival *a) {
+    free(a->gaps);
+    free(a->weights);
+    a->gaps = NULL;
+    a->weights = NULL;
+    a->num_gaps = 0;
+}
@@ -0,0 +1,141 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file arrival.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the arrival processes, which decide when the landing and take-off actors operate.
+ *
+ * An actor waits until the time given by arrival_next_at(), in simulated milliseconds, and then asks arrival_fires()
+ * whether to start an operation. The processes are given by a name:
+ *
+ * - tick: the actor wakes up every ARRIVAL_TICK_MS and operates with the given probability.
+ * - poisson: the actor sleeps for exponentially distributed times, with the same mean rate as tick, and operates
+ *   every time it wakes up.
+ * - poisson:R: like poisson, but R operations per simulated hour, shared by all actors of the kind, so the
+ *   intensity does not depend on their number.
+ * - empirical:FILE: like poisson, but the times are drawn from a file with one time between two operations of the
+ *   airport in seconds per line, optionally followed by its weight. Empty lines and lines starting with '#' are
+ *   ignored. Every actor stretches the times by the number of actors, which keeps the mean rate.
+ *
+ * The tick process counts its ticks from the end of the last operation. The other processes count the time to the next
+ * operation from the time the actor woke up for the last one, so that the time spent on an operation does not lower
+ * their rate. An operation, which is due while the actor is still busy, starts as soon as the actor is done, so the
+ * rate is only kept up while every actor can keep up with its share. The random numbers come from the generator of the
+ * calling thread.
+ *
+ */
+
+#ifndef ARRIVAL_H
+#define ARRIVAL_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Time between two ticks of an actor of the tick process in milliseconds
+ *
+ * */
+#define ARRIVAL_TICK_MS 500
+
+/**
+ * @brief Arrival processes
+ *
+ * */
+enum {
+    ARRIVAL_TICK, /**< Fixed ticks, operating with a probability. */
+    ARRIVAL_POISSON, /**< Exponentially distributed times. */
+    ARRIVAL_EMPIRICAL /**< Times drawn from a file. */
+};
+
+/**
+ * @brief Arrival structure for representing the process of all actors of one kind
+ *
+ * It is not changed after arrival_init(), so actors on several threads can share it.
+ *
+ * */
+typedef struct arrival {
+    int process; /**< One of ARRIVAL_TICK, ARRIVAL_POISSON or ARRIVAL_EMPIRICAL. */
+    int prob; /**< Probability to operate per tick in percent. */
+    double mean; /**< Mean time between two operations of an actor in milliseconds, for ARRIVAL_POISSON. */
+    double *gaps; /**< Times between two operations of an actor in milliseconds, for ARRIVAL_EMPIRICAL. */
+    double *weights; /**< Sum of the weights of the times up to and including each one. */
+    int num_gaps; /**< Length of gaps and weights. */
+} arrival;
+
+/**
+ * @brief Checks the name of an arrival process
+ * @param char* Name of the process, see above
+ * @return The process, or -1 if the name is invalid
+ *
+ * The file of an empirical process is not read.
+ *
+ * */
+int arrival_parse(const char *);
+
+/**
+ * @brief Initializes an arrival process
+ * @param arrival* Pointer to structure to work on
+ * @param char* Name of the process, see above
+ * @param int Probability to operate per tick in percent, between 1 and 100
+ * @param int Number of actors sharing the process
+ * @return True, if the process is valid, false if the name is invalid or the file cannot be read
+ *
+ * After using this structure, it must be freed with arrival_destroy(arrival *), also if this failed.
+ *
+ * */
+bool arrival_init(arrival *, const char *, int, int);
+
+/**
+ * @brief Draws the time until an actor first wakes up
+ * @param arrival* Pointer to structure to work on
+ * @return Simulated milliseconds
+ *
+ * Actors of the tick process wake up at once, the others after a random part of a time between two operations, so
+ * that they do not operate together.
+ *
+ * */
+long long arrival_first(const arrival *);
+
+/**
+ * @brief Draws the time until an actor wakes up again
+ * @param arrival* Pointer to structure to work on
+ * @return Simulated milliseconds
+ *
+ * */
+long long arrival_next(const arrival *);
+
+/**
+ * @brief Draws the time an actor wakes up next
+ * @param arrival* Pointer to structure to work on
+ * @param long-long Time the actor was due to wake up last, in simulated milliseconds
+ * @param long-long Current time, after the actor is done with its operation
+ * @return Time to wake up at, which may have passed already
+ *
+ * Counts from the current time for the tick process and from the last time for the others, see above.
+ *
+ * */
+long long arrival_next_at(const arrival *, long long, long long);
+
+/**
+ * @brief Decides whether an actor, which woke up, starts an operation
+ * @param arrival* Pointer to structure to work on
+ * @return True, if the actor lands or takes off a plane
+ *
+ * Only the tick process draws a random number here, the others always operate.
+ *
+ * */
+bool arrival_fires(const arrival *);
+
+/**
+ * @brief Destructor for arrival
+ * @param arrival* Pointer to structure to be freed
+ *
+ * */
+void arrival_destroy(arrival *);
+
+#endif /* ARRIVAL_H */
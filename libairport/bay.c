@@ -20,6 +20,7 @@
 #include <time.h>
 #include "tools.h"
 #include "bay.h"
+#include "pool.h"
 
 /**
 * @brief Bay structure for representing an instance of a bay
@@ -31,9 +32,38 @@ struct bay {
     int from_runway; /**< Time, the plane was parked or unparked. */
 };
 
+/**
+* @brief Pool all bays are taken from
+*
+*/
+static pool *bay_pool = NULL;
+
+/**
+* @brief Number of reservations of bay_pool
+*
+*/
+static int bay_pool_refs = 0;
+
+void bay_pool_reserve(int n)
+{
+    if(bay_pool == NULL)
+        bay_pool = pool_init(sizeof(bay), n);
+    else
+        pool_reserve(bay_pool, n);
+    bay_pool_refs++;
+}
+
+void bay_pool_release()
+{
+    if(--bay_pool_refs == 0) {
+        pool_destroy(bay_pool);
+        bay_pool = NULL;
+    }
+}
+
 bay *bay_init()
 {
-    bay *b = (bay *)malloc(sizeof(bay));
+    bay *b = (bay *)pool_alloc(bay_pool);
     b->plane = NULL;
     b->parking_time = 0;
     return b;
@@ -50,10 +80,20 @@ time_t bay_get_occupation_time(bay *b)
     }
 }
 
+time_t bay_get_parking_time(bay *b)
+{
+    return b->parking_time;
+}
+
 void bay_park_plane(bay *b, plane *p, int runway)
+{
+    bay_park_plane_at(b, p, runway, current_timestamp());
+}
+
+void bay_park_plane_at(bay *b, plane *p, int runway, time_t parked_at)
 {
     b->plane = p;
-    b->parking_time = current_timestamp();
+    b->parking_time = parked_at;
     b->from_runway = runway;
 }
 
@@ -80,5 +120,5 @@ void bay_destroy(bay *b)
     /* if the bay is being freed with a parking plane, it should be freed, too */
     if(b->plane)
         plane_destroy(b->plane);
-    free(b);
+    pool_free(bay_pool, b);
 }
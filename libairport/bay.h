@@ -25,6 +25,24 @@
  * */
 typedef struct bay bay;
 
+/**
+ * @brief Reserves room for bays in the bay pool
+ * @param int Number of bays
+ *
+ * Bays are taken from a shared object pool, which is created with the first reservation and preallocates the given
+ * number of bays. Every call must be paired with a call to bay_pool_release(). It is not thread safe.
+ *
+ * */
+void bay_pool_reserve(int);
+
+/**
+ * @brief Releases a reservation made with bay_pool_reserve()
+ *
+ * The pool is freed with the last release, together with all bays which have not been destroyed yet.
+ *
+ * */
+void bay_pool_release();
+
 /**
  * @brief constructor for bay
  * @return A pointer to the bay structure, representing the created object
@@ -43,6 +61,14 @@ bay *bay_init();
  * */
 time_t bay_get_occupation_time(bay *b);
 
+/**
+ * @brief Method for getting the time the current plane was parked.
+ * @param bay* Pointer to structure to work on
+ * @return The timestamp of bay_park_plane(), only valid while a plane is parked
+ *
+ * */
+time_t bay_get_parking_time(bay *b);
+
 /**
 * @brief Parks a plane in the given bay
 * @param bay* Pointer to structure to work on
@@ -53,6 +79,18 @@ time_t bay_get_occupation_time(bay *b);
 * */
 void bay_park_plane(bay *b, plane *p, int);
 
+/**
+* @brief Parks a plane in the given bay, as if it had been parked at the given time
+* @param bay* Pointer to structure to work on
+* @param plane* The plane to park
+* @param int Number of the runway the plane came on
+* @param time_t Timestamp the plane was parked at
+*
+* Used to restore a checkpoint, bay_park_plane() takes the current time.
+*
+* */
+void bay_park_plane_at(bay *b, plane *p, int, time_t);
+
 /**
 * @brief Unparks a plane from the given bay
 * @param bay* Pointer to structure to work on
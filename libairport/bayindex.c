@@ -0,0 +1,103 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file bayindex.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods for bayindex class.
+ *
+ * All bay numbers are kept in one array, partitioned by state: occupied bays first, then reserved bays, then free
+ * bays. A second array maps every bay to its position. Changing the state of a bay swaps it with the bay at the border
+ * of its partition and moves the border, which takes at most two swaps.
+ *
+ */
+
+#include <stdlib.h>
+#include "bayindex.h"
+
+/**
+* @brief Bayindex structure for representing an instance of a bay index
+*
+*/
+struct bayindex {
+    int *slots; /**< Bay numbers, partitioned by state. */
+    int *pos; /**< Position of every bay in slots. */
+    int start[BAY_NUM_STATES + 1]; /**< First position of every partition in slots, start[BAY_NUM_STATES] is the number of bays. */
+};
+
+/**
+* @brief Swaps two positions in the slots array
+* @param bayindex* Pointer to structure to work on
+* @param int First position
+* @param int Second position
+*
+* */
+static void swap_slots(bayindex *idx, int i, int j) {
+    int a = idx->slots[i];
+    int b = idx->slots[j];
+    idx->slots[i] = b;
+    idx->slots[j] = a;
+    idx->pos[b] = i;
+    idx->pos[a] = j;
+}
+
+bayindex *bayindex_init(int num_bays) {
+    bayindex *idx = (bayindex *) malloc(sizeof(bayindex));
+    idx->slots = (int *) malloc(num_bays * sizeof(int));
+    idx->pos = (int *) malloc(num_bays * sizeof(int));
+    for (int i = 0; i < num_bays; ++i) {
+        idx->slots[i] = i;
+        idx->pos[i] = i;
+    }
+    /* all bays are free */
+    for (int s = 0; s <= BAY_FREE; ++s)
+        idx->start[s] = 0;
+    idx->start[BAY_NUM_STATES] = num_bays;
+    return idx;
+}
+
+int bayindex_count(bayindex *idx, int state) {
+    return idx->start[state + 1] - idx->start[state];
+}
+
+int bayindex_nth(bayindex *idx, int state, int n) {
+    return idx->slots[idx->start[state] + n];
+}
+
+int bayindex_get(bayindex *idx, int bay_nr) {
+    int p = idx->pos[bay_nr];
+    int state = 0;
+    while (p >= idx->start[state + 1])
+        state++;
+    return state;
+}
+
+void bayindex_set(bayindex *idx, int bay_nr, int state) {
+    int s = bayindex_get(idx, bay_nr);
+    /* move the bay one partition at a time, towards the target state */
+    while (s < state) {
+        /* become the first element of the next partition */
+        int last = idx->start[s + 1] - 1;
+        swap_slots(idx, idx->pos[bay_nr], last);
+        idx->start[s + 1]--;
+        s++;
+    }
+    while (s > state) {
+        /* become the last element of the previous partition */
+        int first = idx->start[s];
+        swap_slots(idx, idx->pos[bay_nr], first);
+        idx->start[s]++;
+        s--;
+    }
+}
+
+void bayindex_destroy(bayindex *idx) {
+    free(idx->slots);
+    free(idx->pos);
+    free(idx);
+}
@@ -0,0 +1,98 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file bayindex.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible bay index methods.
+ *
+ * The bay index keeps track of the state of every bay of an airport. It answers "how many bays are in state X" and
+ * "which is the n-th bay in state X" in constant time, so that a uniformly random free or occupied bay can be picked
+ * without scanning or rejection sampling, independent of the load of the airport.
+ *
+ */
+
+#ifndef BAYINDEX_H
+#define BAYINDEX_H
+
+/**
+ * @brief States a bay can be in
+ *
+ * */
+enum {
+    BAY_OCCUPIED, /**< A plane is parked in the bay. */
+    BAY_RESERVED, /**< The bay is used by a landing or departing plane, but no plane is parked. */
+    BAY_FREE, /**< The bay can be reserved. */
+    BAY_NUM_STATES /**< Number of states. */
+};
+
+/**
+ * @brief Forward declaration for bayindex
+ *
+ * */
+typedef struct bayindex bayindex;
+
+/**
+ * @brief constructor for bayindex
+ * @param int Number of bays, which are all free initially
+ * @return A pointer to the bayindex structure, representing the created object
+ *
+ * After using this structure, it must be freed with bayindex_destroy(bayindex *)
+ *
+ * */
+bayindex *bayindex_init(int);
+
+/**
+ * @brief Gets the number of bays in a state
+ * @param bayindex* Pointer to structure to work on
+ * @param int The state
+ * @return The number of bays in the given state
+ *
+ * */
+int bayindex_count(bayindex *, int);
+
+/**
+ * @brief Gets the n-th bay in a state
+ * @param bayindex* Pointer to structure to work on
+ * @param int The state
+ * @param int Position of the bay among all bays in the given state, must be less than bayindex_count()
+ * @return The number of the bay
+ *
+ * The order of the bays within a state is arbitrary and changes with every call to bayindex_set().
+ *
+ * */
+int bayindex_nth(bayindex *, int, int);
+
+/**
+ * @brief Gets the state of a bay
+ * @param bayindex* Pointer to structure to work on
+ * @param int Number of the bay
+ * @return The state of the bay
+ *
+ * */
+int bayindex_get(bayindex *, int);
+
+/**
+ * @brief Changes the state of a bay
+ * @param bayindex* Pointer to structure to work on
+ * @param int Number of the bay
+ * @param int The new state
+ *
+ * This takes constant time. It is not thread safe.
+ *
+ * */
+void bayindex_set(bayindex *, int, int);
+
+/**
+ * @brief Destructor for bayindex
+ * @param bayindex* Pointer to structure to be freed
+ *
+ * */
+void bayindex_destroy(bayindex *);
+
+#endif /* BAYINDEX_H */
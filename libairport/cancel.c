@@ -0,0 +1,254 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file cancel.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the cancellation token of the simulation.
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#include "cancel.h"
+#include "timesource.h"
+#include "tools.h"
+
+/**
+ * @brief Cancellation was requested, written with the lock held, but read without it
+ *
+ * */
+static bool requested = false;
+
+/**
+ * @brief Number of groups the sleeping threads are spread over, so that they do not share one lock
+ *
+ * */
+#define CANCEL_SLEEPER_GROUPS 64
+
+/**
+ * @brief Size of a cache line in bytes
+ *
+ * */
+#define CACHE_LINE 64
+
+/**
+ * @brief Group of sleeping threads
+ *
+ * */
+typedef struct sleeper_group {
+    pthread_mutex_t lock; /**< Taken by the group's threads to check the request before they sleep. */
+    pthread_cond_t cond; /**< Signalled when cancellation is requested. */
+    char pad[CACHE_LINE]; /**< Keeps the locks of neighbouring groups on different cache lines. */
+} sleeper_group;
+
+/**
+ * @brief Protects the file descriptor and the transitions of requested
+ *
+ * */
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Protects the watches, taken after lock was released, so that the wake functions may use the token
+ *
+ * */
+static pthread_mutex_t watch_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Groups of sleeping threads
+ *
+ * */
+static sleeper_group sleepers[CANCEL_SLEEPER_GROUPS];
+
+/**
+ * @brief Initializes sleepers once
+ *
+ * */
+static pthread_once_t sleepers_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Number of threads, which have slept so far, to spread them over the groups
+ *
+ * */
+static unsigned int num_sleepers = 0;
+
+/**
+ * @brief Group of the calling thread, or -1 until it first sleeps
+ *
+ * */
+static __thread int own_group = -1;
+
+/**
+ * @brief All registered watches
+ *
+ * */
+static cancel_watch *watches = NULL;
+
+/**
+ * @brief Read and write end of the descriptor, which becomes readable when cancellation is requested, or -1 until it
+ * is first needed
+ *
+ * Both ends are the same eventfd where it is available, otherwise they are the two ends of a pipe.
+ *
+ * */
+static int fds[2] = {-1, -1};
+
+/**
+ * @brief Initializes the groups of sleepers, on the clock of timesource_deadline()
+ *
+ * */
+static void init_sleepers() {
+    for (int i = 0; i < CANCEL_SLEEPER_GROUPS; ++i) {
+        pthread_mutex_init(&sleepers[i].lock, NULL);
+        timesource_cond_init(&sleepers[i].cond);
+    }
+}
+
+/**
+ * @brief Makes the descriptor readable
+ *
+ * Writes eight bytes, which an eventfd adds up and a pipe keeps until cancel_reset() reads them.
+ *
+ * */
+static void signal_fd() {
+    uint64_t one = 1;
+    while (write(fds[1], &one, sizeof(one)) < 0 && errno == EINTR);
+}
+
+/**
+ * @brief Opens the descriptor
+ * @return True, if it was opened, false otherwise
+ *
+ * */
+static bool open_fd() {
+#ifdef __linux__
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd >= 0) {
+        fds[0] = fds[1] = fd;
+        return true;
+    }
+#endif
+    if (pipe(fds) != 0)
+        return false;
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+}
+
+void cancel_request() {
+    pthread_once(&sleepers_once, init_sleepers);
+    pthread_mutex_lock(&lock);
+    bool first = !requested;
+    if (first) {
+        __atomic_store_n(&requested, true, __ATOMIC_RELEASE);
+        if (fds[1] >= 0)
+            signal_fd();
+    }
+    pthread_mutex_unlock(&lock);
+    if (!first)
+        return;
+    /* a sleeper checks the request with the lock of its group held, so it either sees it or gets woken up */
+    for (int i = 0; i < CANCEL_SLEEPER_GROUPS; ++i) {
+        pthread_mutex_lock(&sleepers[i].lock);
+        pthread_cond_broadcast(&sleepers[i].cond);
+        pthread_mutex_unlock(&sleepers[i].lock);
+    }
+    /* a waiter registered later checks the request itself, before it blocks */
+    pthread_mutex_lock(&watch_lock);
+    for (cancel_watch *w = watches; w != NULL; w = w->next)
+        w->wake(w->arg);
+    pthread_mutex_unlock(&watch_lock);
+}
+
+bool cancel_requested() {
+    return __atomic_load_n(&requested, __ATOMIC_ACQUIRE);
+}
+
+void cancel_reset() {
+    pthread_mutex_lock(&lock);
+    __atomic_store_n(&requested, false, __ATOMIC_RELEASE);
+    if (fds[0] >= 0) {
+        /* the read end is non-blocking, so this stops at the last byte */
+        uint64_t value;
+        while (read(fds[0], &value, sizeof(value)) > 0);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+bool cancel_sleep(long long m) {
+    /* a sleep after the request needs no lock at all */
+    if (cancel_requested())
+        return false;
+    pthread_once(&sleepers_once, init_sleepers);
+    if (own_group < 0)
+        own_group = __atomic_fetch_add(&num_sleepers, 1, __ATOMIC_RELAXED) % CANCEL_SLEEPER_GROUPS;
+    sleeper_group *g = &sleepers[own_group];
+    struct timespec deadline;
+    timesource_deadline(&deadline, m);
+
+    pthread_mutex_lock(&g->lock);
+    while (!cancel_requested()) {
+        if (pthread_cond_timedwait(&g->cond, &g->lock, &deadline) == ETIMEDOUT)
+            break;
+    }
+    bool slept = !cancel_requested();
+    pthread_mutex_unlock(&g->lock);
+    return slept;
+}
+
+bool cancel_sleep_until(long long t) {
+    long long m = t - current_timestamp();
+    return cancel_sleep(m > 0 ? m : 0);
+}
+
+int cancel_get_fd() {
+    pthread_mutex_lock(&lock);
+    if (fds[0] < 0) {
+        if (!open_fd()) {
+            pthread_mutex_unlock(&lock);
+            return -1;
+        }
+        /* a late reader still has to see the request */
+        if (requested)
+            signal_fd();
+    }
+    int fd = fds[0];
+    pthread_mutex_unlock(&lock);
+    return fd;
+}
+
+void cancel_watch_add(cancel_watch *w, void (*wake)(void *), void *arg) {
+    w->wake = wake;
+    w->arg = arg;
+    pthread_mutex_lock(&watch_lock);
+    w->prev = NULL;
+    w->next = watches;
+    if (watches != NULL)
+        watches->prev = w;
+    watches = w;
+    pthread_mutex_unlock(&watch_lock);
+}
+
+void cancel_watch_remove(cancel_watch *w) {
+    pthread_mutex_lock(&watch_lock);
+    if (w->prev != NULL)
+        w->prev->next = w->next;
+    else
+        watches = w->next;
+    if (w->next != NULL)
+        w->next->prev = w->prev;
+    pthread_mutex_unlock(&watch_lock);
+}
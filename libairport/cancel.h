@@ -0,0 +1,110 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file cancel.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the cancellation token of the simulation.
+ *
+ * The cancellation token tells all threads to shut down. Once it is requested, every sleep with cancel_sleep() and
+ * every wait of a registered watcher, like an admission queue, returns immediately. Threads blocking in poll() can
+ * wait for the token's file descriptor to become readable, an eventfd where it is available and a pipe otherwise.
+ *
+ * Sleeping threads are spread over groups with a lock each, so that sleeps of many threads do not contend.
+ *
+ */
+
+#ifndef CANCEL_H
+#define CANCEL_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Registration of a blocking wait, which has to be woken up when cancellation is requested
+ *
+ * The structure must not be copied while it is registered.
+ *
+ * */
+typedef struct cancel_watch {
+    void (*wake)(void *); /**< Wakes up the waiters, called with the list of watches locked. */
+    void *arg; /**< Argument passed to wake. */
+    struct cancel_watch *prev; /**< Previous registered watch. */
+    struct cancel_watch *next; /**< Next registered watch. */
+} cancel_watch;
+
+/**
+ * @brief Requests cancellation
+ *
+ * Wakes up all sleeping threads and registered watchers. It is thread safe and can be called more than once.
+ *
+ * */
+void cancel_request();
+
+/**
+ * @brief Checks if cancellation was requested
+ * @return True, if the threads have to shut down
+ *
+ * It does not take any lock.
+ *
+ * */
+bool cancel_requested();
+
+/**
+ * @brief Withdraws a request for cancellation, to run the simulation again in the same process
+ *
+ * No thread may wait or sleep while it is called.
+ *
+ * */
+void cancel_reset();
+
+/**
+ * @brief Sleeps until the given time has passed or cancellation is requested
+ * @param long-long The time in simulated milliseconds, see timesource_set_speed()
+ * @return True, if the whole time was slept, false if the sleep was cancelled
+ *
+ * */
+bool cancel_sleep(long long);
+
+/**
+ * @brief Sleeps until the given point in time or until cancellation is requested
+ * @param long-long The time in simulated milliseconds, as returned by current_timestamp()
+ * @return True, if the time was reached, false if the sleep was cancelled
+ *
+ * A time, which has passed already, returns at once.
+ *
+ * */
+bool cancel_sleep_until(long long);
+
+/**
+ * @brief Gets a file descriptor, which becomes readable when cancellation is requested
+ * @return The file descriptor, which must not be read or closed by the caller
+ *
+ * */
+int cancel_get_fd();
+
+/**
+ * @brief Registers a blocking wait
+ * @param cancel_watch* The registration, which must stay valid until it is removed
+ * @param void(*)(void*) Function waking up the waiters, which must not add or remove a watch
+ * @param void* Argument passed to the function
+ *
+ * A waiter has to check cancel_requested() with the same lock held, which the wake function takes, before it blocks.
+ * The wake functions are called after the request is visible and the token's own lock is released, so they may call
+ * cancel_requested(), cancel_sleep() or cancel_get_fd().
+ *
+ * */
+void cancel_watch_add(cancel_watch *, void (*)(void *), void *);
+
+/**
+ * @brief Removes a registered blocking wait
+ * @param cancel_watch* The registration
+ *
+ * */
+void cancel_watch_remove(cancel_watch *);
+
+#endif /* CANCEL_H */
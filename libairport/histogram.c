@@ -0,0 +1,150 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file histogram.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods for the histogram class.
+ *
+ * Bucket i < 128 holds the value i. Above, each power of two 2^k with k >= 7 is split into 64 buckets of width
+ * 2^(k-6).
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "histogram.h"
+
+/**
+ * @brief Number of bits of a value, which are kept exactly
+ *
+ * */
+#define HISTOGRAM_SUB_BITS 7
+
+/**
+ * @brief Number of buckets per power of two
+ *
+ * */
+#define HISTOGRAM_HALF (1L << (HISTOGRAM_SUB_BITS - 1))
+
+/**
+ * @brief Values from 2^HISTOGRAM_MAX_BITS on are counted in the last bucket
+ *
+ * */
+#define HISTOGRAM_MAX_BITS 40
+
+/**
+ * @brief Number of buckets
+ *
+ * */
+#define HISTOGRAM_BUCKETS ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 2) * HISTOGRAM_HALF)
+
+/**
+ * @brief Histogram structure for representing a histogram
+ *
+ * Only the writer changes the fields, with relaxed atomic stores, so that merging threads never see torn values.
+ *
+ */
+struct histogram {
+    unsigned long count; /**< Number of recorded values. */
+    long max; /**< Largest recorded value. */
+    unsigned long counts[HISTOGRAM_BUCKETS]; /**< Number of recorded values per bucket. */
+};
+
+/**
+ * @brief Gets the bucket of a value
+ * @param long The value, between 0 and 2^HISTOGRAM_MAX_BITS - 1
+ * @return The index of the bucket
+ *
+ * */
+static int bucket_of(long value) {
+    if (value < 2 * HISTOGRAM_HALF)
+        return (int) value;
+    int shift = 63 - __builtin_clzll(value) - HISTOGRAM_SUB_BITS + 1;
+    return (int) ((shift + 1) * HISTOGRAM_HALF + (value >> shift) - HISTOGRAM_HALF);
+}
+
+/**
+ * @brief Gets the largest value of a bucket
+ * @param int The index of the bucket
+ * @return The largest value, which is counted in the bucket
+ *
+ * */
+static long highest_of(int bucket) {
+    if (bucket < 2 * HISTOGRAM_HALF)
+        return bucket;
+    int shift = bucket / HISTOGRAM_HALF - 1;
+    long sub = bucket % HISTOGRAM_HALF + HISTOGRAM_HALF;
+    return ((sub + 1) << shift) - 1;
+}
+
+histogram *histogram_init() {
+    return (histogram *) calloc(1, sizeof(histogram));
+}
+
+void histogram_record(histogram *h, long value) {
+    if (value < 0)
+        value = 0;
+    if (value >= 1L << HISTOGRAM_MAX_BITS)
+        value = (1L << HISTOGRAM_MAX_BITS) - 1;
+    int b = bucket_of(value);
+    /* the only writer needs no read-modify-write */
+    __atomic_store_n(&h->counts[b], h->counts[b] + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&h->count, h->count + 1, __ATOMIC_RELAXED);
+    if (value > h->max)
+        __atomic_store_n(&h->max, value, __ATOMIC_RELAXED);
+}
+
+void histogram_merge(histogram *dst, const histogram *src) {
+    unsigned long count = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        unsigned long n = __atomic_load_n(&src->counts[i], __ATOMIC_RELAXED);
+        dst->counts[i] += n;
+        count += n;
+    }
+    /* the sum of the buckets, so that the count matches the buckets while src is written */
+    dst->count += count;
+    long max = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+    if (max > dst->max)
+        dst->max = max;
+}
+
+unsigned long histogram_count(const histogram *h) {
+    return __atomic_load_n(&h->count, __ATOMIC_RELAXED);
+}
+
+long histogram_max(const histogram *h) {
+    return __atomic_load_n(&h->max, __ATOMIC_RELAXED);
+}
+
+long histogram_percentile(const histogram *h, double percentile) {
+    if (h->count == 0)
+        return 0;
+    /* rank of the value at the percentile, counted from 1 */
+    double r = percentile / 100.0 * h->count;
+    unsigned long rank = (unsigned long) r;
+    if (rank < r)
+        rank++;
+    if (rank < 1)
+        rank = 1;
+    unsigned long seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        seen += h->counts[i];
+        if (seen >= rank)
+            return highest_of(i) < h->max ? highest_of(i) : h->max;
+    }
+    return h->max;
+}
+
+void histogram_reset(histogram *h) {
+    memset(h, 0, sizeof(histogram));
+}
+
+void histogram_destroy(histogram *h) {
+    free(h);
+}
@@ -0,0 +1,99 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file histogram.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible histogram methods.
+ *
+ * The histogram counts values in log-linear buckets: every power of two is split into 64 buckets of equal width, so
+ * values are kept with a relative error below 1.6 percent, from one to 2^40. Values below 128 are kept exactly.
+ * Recording takes constant time and never allocates.
+ *
+ * A histogram has a single writer. Other threads can merge it into their own histogram at any time, while it is
+ * written to.
+ *
+ */
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+/**
+ * @brief Forward declaration for histogram
+ *
+ * */
+typedef struct histogram histogram;
+
+/**
+ * @brief constructor for histogram
+ * @return A pointer to the histogram structure, representing the created object
+ *
+ * The histogram is empty. After using this structure, it must be freed with histogram_destroy(histogram *)
+ *
+ * */
+histogram *histogram_init();
+
+/**
+ * @brief Records a value
+ * @param histogram* Pointer to structure to work on
+ * @param long The value, negative values are recorded as 0, values from 2^40 on as 2^40 - 1
+ *
+ * Only one thread may record into a histogram.
+ *
+ * */
+void histogram_record(histogram *, long);
+
+/**
+ * @brief Adds all values of a histogram to another one
+ * @param histogram* Histogram to add to, which must not be written by other threads
+ * @param histogram* Histogram to add, which may be written by its thread in the meantime
+ *
+ * */
+void histogram_merge(histogram *, const histogram *);
+
+/**
+ * @brief Gets the number of recorded values
+ * @param histogram* Pointer to structure to work on
+ * @return Number of recorded values
+ *
+ * */
+unsigned long histogram_count(const histogram *);
+
+/**
+ * @brief Gets the largest recorded value
+ * @param histogram* Pointer to structure to work on
+ * @return The largest value, or 0 if nothing was recorded
+ *
+ * */
+long histogram_max(const histogram *);
+
+/**
+ * @brief Gets a percentile of the recorded values
+ * @param histogram* Pointer to structure to work on
+ * @param double The percentile, between 0 and 100
+ * @return The largest value, which falls into the same bucket as the value at the percentile, but at most the
+ * largest recorded value, or 0 if nothing was recorded
+ *
+ * */
+long histogram_percentile(const histogram *, double);
+
+/**
+ * @brief Removes all values
+ * @param histogram* Pointer to structure to work on
+ *
+ * */
+void histogram_reset(histogram *);
+
+/**
+ * @brief Destructor for histogram
+ * @param histogram* Pointer to structure to be freed
+ *
+ * */
+void histogram_destroy(histogram *);
+
+#endif /* HISTOGRAM_H */
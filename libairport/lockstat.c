@@ -0,0 +1,187 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file lockstat.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the instrumented mutex.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lockstat.h"
+#include "timesource.h"
+
+/**
+ * @brief Maximum number of lock names in a report
+ *
+ * */
+#define LOCKSTAT_MAX_NAMES 16
+
+/**
+ * @brief Statistics of all locks with the same name
+ *
+ * */
+typedef struct lock_summary {
+    const char *name; /**< Name of the locks. */
+    int instances; /**< Number of locks. */
+    unsigned long acquisitions; /**< Sum of acquisitions. */
+    unsigned long contended; /**< Sum of contended acquisitions. */
+    uint64_t wait_ns; /**< Sum of wait times. */
+    uint64_t max_hold_ns; /**< Longest hold time of any of the locks. */
+} lock_summary;
+
+/**
+ * @brief Profiling is on
+ *
+ * */
+static bool enabled = false;
+
+/**
+ * @brief All registered locks
+ *
+ * */
+static lockstat *locks = NULL;
+
+/**
+ * @brief Protects the list of locks
+ *
+ * */
+static pthread_mutex_t locks_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void lockstat_enable(bool on) {
+    enabled = on;
+}
+
+bool lockstat_enabled() {
+    return enabled;
+}
+
+void lockstat_init(lockstat *l, const char *name) {
+    pthread_mutex_init(&l->mutex, NULL);
+    l->name = name;
+    l->acquisitions = l->contended = 0;
+    l->wait_ns = l->max_hold_ns = l->acquired_ns = 0;
+    pthread_mutex_lock(&locks_lock);
+    l->prev = NULL;
+    l->next = locks;
+    if (locks)
+        locks->prev = l;
+    locks = l;
+    pthread_mutex_unlock(&locks_lock);
+}
+
+void lockstat_lock(lockstat *l) {
+    if (!enabled) {
+        pthread_mutex_lock(&l->mutex);
+        return;
+    }
+    if (pthread_mutex_trylock(&l->mutex) == 0) {
+        l->acquired_ns = timesource_now_ns();
+    } else {
+        uint64_t start = timesource_now_ns();
+        pthread_mutex_lock(&l->mutex);
+        l->acquired_ns = timesource_now_ns();
+        /* readers load the statistics without the lock */
+        __atomic_store_n(&l->contended, l->contended + 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&l->wait_ns, l->wait_ns + (l->acquired_ns - start), __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&l->acquisitions, l->acquisitions + 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Records how long the lock was held, before the holder releases it
+ * @param lockstat* The lock, held by the calling thread
+ *
+ * */
+static inline void record_hold(lockstat *l) {
+    uint64_t hold = timesource_now_ns() - l->acquired_ns;
+    if (hold > l->max_hold_ns)
+        __atomic_store_n(&l->max_hold_ns, hold, __ATOMIC_RELAXED);
+}
+
+void lockstat_unlock(lockstat *l) {
+    if (enabled)
+        record_hold(l);
+    pthread_mutex_unlock(&l->mutex);
+}
+
+int lockstat_timedwait(lockstat *l, pthread_cond_t *cond, const struct timespec *deadline) {
+    if (!enabled)
+        return pthread_cond_timedwait(cond, &l->mutex, deadline);
+    record_hold(l);
+    int rc = pthread_cond_timedwait(cond, &l->mutex, deadline);
+    l->acquired_ns = timesource_now_ns();
+    __atomic_store_n(&l->acquisitions, l->acquisitions + 1, __ATOMIC_RELAXED);
+    return rc;
+}
+
+void lockstat_destroy(lockstat *l) {
+    pthread_mutex_lock(&locks_lock);
+    if (l->prev)
+        l->prev->next = l->next;
+    else
+        locks = l->next;
+    if (l->next)
+        l->next->prev = l->prev;
+    pthread_mutex_unlock(&locks_lock);
+    pthread_mutex_destroy(&l->mutex);
+}
+
+char *lockstat_to_string(bool machine) {
+    lock_summary sums[LOCKSTAT_MAX_NAMES];
+    int num_names = 0;
+
+    /* sum up the locks by name, there are few names, but maybe many locks */
+    pthread_mutex_lock(&locks_lock);
+    for (lockstat *l = locks; l != NULL; l = l->next) {
+        int i = 0;
+        while (i < num_names && strcmp(sums[i].name, l->name) != 0)
+            ++i;
+        if (i == LOCKSTAT_MAX_NAMES)
+            continue;
+        if (i == num_names) {
+            memset(&sums[i], 0, sizeof(lock_summary));
+            sums[i].name = l->name;
+            num_names++;
+        }
+        sums[i].instances++;
+        sums[i].acquisitions += __atomic_load_n(&l->acquisitions, __ATOMIC_RELAXED);
+        sums[i].contended += __atomic_load_n(&l->contended, __ATOMIC_RELAXED);
+        sums[i].wait_ns += __atomic_load_n(&l->wait_ns, __ATOMIC_RELAXED);
+        uint64_t max = __atomic_load_n(&l->max_hold_ns, __ATOMIC_RELAXED);
+        if (max > sums[i].max_hold_ns)
+            sums[i].max_hold_ns = max;
+    }
+    pthread_mutex_unlock(&locks_lock);
+
+    size_t size = 256 * (num_names + 1);
+    char *c = malloc(size);
+    size_t len = 0;
+    c[0] = '\0';
+    if (!machine)
+        len += snprintf(c, size, "%-20s %6s %12s %12s %10s %12s %12s\n", "lock", "locks", "acquired", "contended",
+                        "contended%", "wait [ms]", "max hold[us]");
+    for (int i = 0; i < num_names; ++i) {
+        lock_summary *s = &sums[i];
+        double percent = s->acquisitions > 0 ? 100.0 * s->contended / s->acquisitions : 0;
+        if (machine)
+            len += snprintf(c + len, size - len,
+                            "lock_%s_acquisitions=%lu\nlock_%s_contended=%lu\nlock_%s_wait_ms=%.3f\n"
+                            "lock_%s_max_hold_us=%.3f\n",
+                            s->name, s->acquisitions, s->name, s->contended, s->name, s->wait_ns / 1e6, s->name,
+                            s->max_hold_ns / 1e3);
+        else
+            len += snprintf(c + len, size - len, "%-20s %6d %12lu %12lu %10.2f %12.3f %12.3f\n", s->name,
+                            s->instances, s->acquisitions, s->contended, percent, s->wait_ns / 1e6,
+                            s->max_hold_ns / 1e3);
+    }
+    return c;
+}
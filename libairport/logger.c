@@ -0,0 +1,314 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file logger.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the logger and its writer thread.
+ *
+ * Every thread creates its ring buffer on its first event and registers it in a list, which is only ever prepended
+ * to, so the writer thread can walk it without a lock. The writer drains all rings in turn and sleeps for a
+ * millisecond when there was nothing to print. Events of one thread are printed in order; events of different
+ * threads may interleave slightly out of order.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+#include <sched.h>
+#include "logger.h"
+#include "ring.h"
+#include "tools.h"
+
+/**
+* @brief Number of events a thread's ring buffer can hold
+*
+*/
+#define LOGGER_RING_SIZE 4096
+
+/**
+* @brief Size of plane names in a record
+*
+*/
+#define LOGGER_NAME_SIZE 8
+
+/**
+* @brief Binary representation of a logged event
+*
+*/
+typedef struct log_record {
+    time_t time; /**< Timestamp of the event in milliseconds. */
+    long value; /**< Additional value, depending on the type. */
+    int type; /**< Event type. */
+    int bay; /**< Bay number, or -1. */
+    int runway; /**< Runway number, or -1. */
+    char plane[LOGGER_NAME_SIZE]; /**< Name of the plane, not necessarily zero terminated. */
+} log_record;
+
+/**
+* @brief Ring buffer of one thread, linked into the list of all rings
+*
+*/
+typedef struct log_ring {
+    ring *r; /**< The ring buffer. */
+    unsigned long dropped; /**< Number of events dropped because the ring was full. */
+    struct log_ring *next; /**< Next registered ring. */
+} log_ring;
+
+/**
+* @brief Level of each event type
+*
+*/
+static const int event_levels[LOGGER_NUM_EVENTS] = {
+    [LOGGER_LANDING] = LOGGER_INFO,
+    [LOGGER_PARKED] = LOGGER_INFO,
+    [LOGGER_FULL] = LOGGER_INFO,
+    [LOGGER_TAKEOFF] = LOGGER_INFO,
+    [LOGGER_DEPARTED] = LOGGER_INFO,
+    [LOGGER_EMPTY] = LOGGER_INFO,
+    [LOGGER_TURNED_AWAY] = LOGGER_WARN,
+    [LOGGER_STAYED] = LOGGER_WARN
+};
+
+/**
+* @brief Names of the log levels
+*
+*/
+static const char *level_names[] = {"off", "error", "warn", "info", "debug"};
+
+/**
+* @brief Current log level
+*
+*/
+static int level = LOGGER_OFF;
+
+/**
+* @brief Wait for room in the ring instead of dropping events
+*
+*/
+static bool blocking = false;
+
+/**
+* @brief Stream the writer prints to
+*
+*/
+static FILE *out = NULL;
+
+/**
+* @brief Time logger_init() was called, timestamps are printed relative to it
+*
+*/
+static time_t start_time = 0;
+
+/**
+* @brief Incremented by every logger_init(), so that threads notice their ring belongs to a previous logger
+*
+*/
+static unsigned long generation = 0;
+
+/**
+* @brief All registered rings
+*
+*/
+static log_ring *rings = NULL;
+
+/**
+* @brief Protects the registration of rings
+*
+*/
+static pthread_mutex_t rings_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+* @brief Tells the writer thread to exit after draining all rings
+*
+*/
+static bool stopping = false;
+
+/**
+* @brief The writer thread
+*
+*/
+static pthread_t writer;
+
+/**
+* @brief Ring of the current thread
+*
+*/
+static __thread log_ring *local_ring = NULL;
+
+/**
+* @brief Generation of the logger, local_ring belongs to
+*
+*/
+static __thread unsigned long local_generation = 0;
+
+/**
+* @brief Prints a record in human readable form
+* @param log_record* The record
+*
+* */
+static void print_record(const log_record *rec) {
+    char name[LOGGER_NAME_SIZE + 1];
+    memcpy(name, rec->plane, LOGGER_NAME_SIZE);
+    name[LOGGER_NAME_SIZE] = 0;
+
+    fprintf(out, "[%10.3f] ", (rec->time - start_time) / 1000.0);
+    switch (rec->type) {
+        case LOGGER_LANDING:
+            fprintf(out, "Plane %s is landing on runway %d...\n", name, rec->runway);
+            break;
+        case LOGGER_PARKED:
+            fprintf(out, "Plane %s parked in landing bay %d.\n", name, rec->bay);
+            break;
+        case LOGGER_FULL:
+            fprintf(out, "The airport is full\n");
+            break;
+        case LOGGER_TAKEOFF:
+            fprintf(out, "After staying at bay %d for %.2f seconds, plane %s is taking off on runway %d...\n",
+                    rec->bay, rec->value / 1000.0f, name, rec->runway);
+            break;
+        case LOGGER_DEPARTED:
+            fprintf(out, "Plane %s has finished taking off on runway %d.\n", name, rec->runway);
+            break;
+        case LOGGER_EMPTY:
+            fprintf(out, "The airport is empty\n");
+            break;
+        case LOGGER_TURNED_AWAY:
+            fprintf(out, "Plane %s was turned away, no runway got free in time.\n", name);
+            break;
+        case LOGGER_STAYED:
+            fprintf(out, "No runway got free in time, the plane stays in its bay.\n");
+            break;
+    }
+}
+
+/**
+* @brief Drains all rings once
+* @return The number of printed records
+*
+* */
+static unsigned long drain_rings() {
+    unsigned long n = 0;
+    log_record rec;
+    for (log_ring *lr = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); lr != NULL; lr = lr->next) {
+        while (ring_pop(lr->r, &rec)) {
+            print_record(&rec);
+            n++;
+        }
+    }
+    return n;
+}
+
+/**
+* @brief Writer thread
+*
+* Prints the records of all rings until the logger is stopped.
+*
+* */
+static void *writer_thread_func(void *arg) {
+    while (!__atomic_load_n(&stopping, __ATOMIC_ACQUIRE)) {
+        if (drain_rings() == 0) {
+            fflush(out);
+            msleep(1);
+        }
+    }
+    /* the producers are done, print what is left */
+    drain_rings();
+    fflush(out);
+    return NULL;
+}
+
+/**
+* @brief Gets the ring of the calling thread, and creates it on first use
+* @return The ring of the calling thread
+*
+* */
+static log_ring *get_local_ring() {
+    if (local_ring != NULL && local_generation == generation)
+        return local_ring;
+    log_ring *lr = (log_ring *) malloc(sizeof(log_ring));
+    lr->r = ring_init(sizeof(log_record), LOGGER_RING_SIZE);
+    lr->dropped = 0;
+    pthread_mutex_lock(&rings_lock);
+    lr->next = rings;
+    __atomic_store_n(&rings, lr, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&rings_lock);
+    local_ring = lr;
+    local_generation = generation;
+    return lr;
+}
+
+void logger_init(int lvl, FILE *stream, bool block) {
+    out = stream;
+    blocking = block;
+    start_time = current_timestamp();
+    stopping = false;
+    generation++;
+    level = lvl;
+    if (level > LOGGER_OFF)
+        pthread_create(&writer, NULL, writer_thread_func, NULL);
+}
+
+int logger_parse_level(const char *name) {
+    for (int i = 0; i <= LOGGER_DEBUG; ++i) {
+        if (!strcasecmp(name, level_names[i]))
+            return i;
+    }
+    return -1;
+}
+
+bool logger_enabled(int type) {
+    return event_levels[type] <= level;
+}
+
+void logger_event(int type, const char *plane, int bay, int runway, long value) {
+    if (event_levels[type] > level)
+        return;
+    log_record rec;
+    rec.time = current_timestamp();
+    rec.value = value;
+    rec.type = type;
+    rec.bay = bay;
+    rec.runway = runway;
+    if (plane)
+        strncpy(rec.plane, plane, LOGGER_NAME_SIZE);
+    else
+        memset(rec.plane, 0, LOGGER_NAME_SIZE);
+
+    log_ring *lr = get_local_ring();
+    while (!ring_push(lr->r, &rec)) {
+        if (!blocking) {
+            lr->dropped++;
+            return;
+        }
+        sched_yield();
+    }
+}
+
+void logger_destroy() {
+    if (level > LOGGER_OFF) {
+        __atomic_store_n(&stopping, true, __ATOMIC_RELEASE);
+        pthread_join(writer, NULL);
+    }
+    level = LOGGER_OFF;
+
+    unsigned long dropped = 0;
+    pthread_mutex_lock(&rings_lock);
+    while (rings) {
+        log_ring *lr = rings;
+        rings = lr->next;
+        dropped += __atomic_load_n(&lr->dropped, __ATOMIC_RELAXED);
+        ring_destroy(lr->r);
+        free(lr);
+    }
+    pthread_mutex_unlock(&rings_lock);
+    if (dropped > 0)
+        fprintf(stderr, "Logger dropped %lu events\n", dropped);
+}
@@ -0,0 +1,103 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file logger.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible logger methods.
+ *
+ * The logger takes the formatting and printing of log messages off the simulation threads. Every thread pushes compact
+ * binary event records into its own ring buffer, and a dedicated writer thread formats and prints them. Logging an
+ * event never blocks on the output stream.
+ *
+ */
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * @brief Log levels, every level includes the ones before it
+ *
+ * */
+enum {
+    LOGGER_OFF, /**< Nothing is logged and no writer thread is started. */
+    LOGGER_ERROR, /**< Errors only. */
+    LOGGER_WARN, /**< Operations, which were given up. */
+    LOGGER_INFO, /**< Every landing and take-off. */
+    LOGGER_DEBUG /**< Everything. */
+};
+
+/**
+ * @brief Types of logged events
+ *
+ * */
+enum {
+    LOGGER_LANDING, /**< A plane started landing on a runway. */
+    LOGGER_PARKED, /**< A plane was parked in a bay. */
+    LOGGER_FULL, /**< The airport became full. */
+    LOGGER_TAKEOFF, /**< A plane left its bay and started taking off, value is the parking time in ms. */
+    LOGGER_DEPARTED, /**< A plane finished taking off. */
+    LOGGER_EMPTY, /**< The airport became empty. */
+    LOGGER_TURNED_AWAY, /**< A landing plane got no runway in time. */
+    LOGGER_STAYED, /**< A take-off got no runway in time, the plane stays parked. */
+    LOGGER_NUM_EVENTS /**< Number of event types. */
+};
+
+/**
+ * @brief Starts the logger
+ * @param int Log level
+ * @param FILE* Stream the writer thread prints to
+ * @param bool If true, threads wait for room in their ring buffer instead of dropping events
+ *
+ * Timestamps are printed relative to the time of this call. Events logged before are dropped.
+ *
+ * */
+void logger_init(int, FILE *, bool);
+
+/**
+ * @brief Converts the name of a log level
+ * @param char* Name of the level: off, error, warn, info or debug
+ * @return The log level, or -1 if the name is unknown
+ *
+ * */
+int logger_parse_level(const char *);
+
+/**
+ * @brief Checks if an event type is logged
+ * @param int Event type
+ * @return True, if events of this type are logged at the current level
+ *
+ * */
+bool logger_enabled(int);
+
+/**
+ * @brief Logs an event
+ * @param int Event type
+ * @param char* Name of the plane, or NULL
+ * @param int Bay number, or -1
+ * @param int Runway number, or -1
+ * @param long Additional value, depending on the event type
+ *
+ * The event is copied into the ring buffer of the calling thread. If the buffer is full, the event is dropped, unless
+ * the logger was started in blocking mode. It is thread safe and does not take any lock.
+ *
+ * */
+void logger_event(int, const char *, int, int, long);
+
+/**
+ * @brief Stops the logger
+ *
+ * All pending events are printed before the writer thread exits. The number of dropped events is reported on stderr.
+ *
+ * */
+void logger_destroy();
+
+#endif /* LOGGER_H */
@@ -0,0 +1,93 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file plane.c
+ * @author Lukas Elsner
+ * @date 01-09-2014
+ * @brief File containing the plane structure and its member methods.
+ *
+ * A plane is generated by the landing thread and stored in a bay of the airport.
+ *
+ */
+#include <time.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tools.h"
+#include "plane.h"
+#include "pool.h"
+
+/**
+* @brief Number of letters in the name of a plane
+*
+*/
+#define PLANE_NAME_LETTERS 2
+
+/**
+* @brief Number of digits in the name of a plane
+*
+*/
+#define PLANE_NAME_DIGITS 4
+
+/**
+* @brief Plane structure for representing an instance of a plane
+*
+* The name is stored inline, so that a plane is a single small record without further allocations.
+*
+*/
+struct plane {
+  char name[PLANE_NAME_LETTERS + PLANE_NAME_DIGITS + 2]; /**< Name of the plane, zero terminated and padded to 8 bytes. */
+};
+
+/**
+* @brief Pool all planes are taken from
+*
+*/
+static pool *plane_pool = NULL;
+
+/**
+* @brief Number of reservations of plane_pool
+*
+*/
+static int plane_pool_refs = 0;
+
+void plane_pool_reserve(int n) {
+  if (plane_pool == NULL)
+    plane_pool = pool_init(sizeof(plane), n);
+  else
+    pool_reserve(plane_pool, n);
+  plane_pool_refs++;
+}
+
+void plane_pool_release() {
+  if (--plane_pool_refs == 0) {
+    pool_destroy(plane_pool);
+    plane_pool = NULL;
+  }
+}
+
+plane *plane_init() {
+  plane *p = (plane *)pool_alloc(plane_pool);
+  generate_rand_into(p->name, PLANE_NAME_LETTERS, PLANE_NAME_DIGITS);
+  p->name[sizeof(p->name) - 1] = 0;
+  return p;
+}
+
+plane *plane_init_named(const char *name) {
+  plane *p = (plane *)pool_alloc(plane_pool);
+  strncpy(p->name, name, sizeof(p->name) - 1);
+  p->name[sizeof(p->name) - 1] = 0;
+  return p;
+}
+
+char *plane_get_name(plane *p) {
+  return p->name;
+}
+
+void plane_destroy(plane *p) {
+  pool_free(plane_pool, p);
+}
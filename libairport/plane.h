@@ -24,6 +24,24 @@
  * */
 typedef struct plane plane;
 
+/**
+ * @brief Reserves room for planes in the plane pool
+ * @param int Number of planes
+ *
+ * Planes are taken from a shared object pool, which is created with the first reservation and preallocates the given
+ * number of planes. Every call must be paired with a call to plane_pool_release(). It is not thread safe.
+ *
+ * */
+void plane_pool_reserve(int);
+
+/**
+ * @brief Releases a reservation made with plane_pool_reserve()
+ *
+ * The pool is freed with the last release, together with all planes which have not been destroyed yet.
+ *
+ * */
+void plane_pool_release();
+
 /**
  * @brief constructor for plane
  * @return A pointer to the plane structure, representing the created object
@@ -33,10 +51,20 @@ typedef struct plane plane;
  * */
 plane *plane_init();
 
+/**
+ * @brief constructor for a plane with a given name
+ * @param char* Name of the plane, of which at most 7 characters are kept
+ * @return A pointer to the plane structure, representing the created object
+ *
+ * After using this structure, it must be freed with plane_destroy(plane *)
+ *
+ * */
+plane *plane_init_named(const char *);
+
 /**
  * @brief Method for getting the name of a plane structure
  * @param plane* Pointer to structure to work on
- * @return A pointer to a string representation of passed structure. Must be freed by caller.
+ * @return A pointer to the name of the plane, which is valid until the plane is destroyed.
  *
  * */
 char *plane_get_name(plane *);
@@ -0,0 +1,266 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file pool.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods for pool class.
+ *
+ * Free objects are linked into a list through their first bytes. The list is protected by a mutex, which is only taken
+ * to move a batch of objects between the list and the cache of a thread. Up to POOL_MAX_CACHED pools have per-thread
+ * caches at the same time; further pools work on the shared list directly.
+ *
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "lockstat.h"
+#include "pool.h"
+
+/**
+* @brief Number of free objects a thread caches per pool
+*
+*/
+#define POOL_CACHE_SIZE 16
+
+/**
+* @brief Number of pools, which can have per-thread caches at the same time
+*
+*/
+#define POOL_MAX_CACHED 8
+
+/**
+* @brief Alignment of objects in a slab
+*
+*/
+#define POOL_ALIGN 16
+
+/**
+* @brief Header of a slab of objects, the objects follow it directly
+*
+*/
+typedef struct slab {
+    struct slab *next; /**< Next slab of the pool. */
+} slab;
+
+/**
+* @brief Free object, linked into the free list of a pool
+*
+*/
+typedef struct free_obj {
+    struct free_obj *next; /**< Next free object. */
+} free_obj;
+
+/**
+* @brief Pool structure for representing an instance of an object pool
+*
+*/
+struct pool {
+    size_t objsize; /**< Size of the objects, rounded up to POOL_ALIGN. */
+    size_t slab_objs; /**< Number of objects in a slab added when the pool is exhausted. */
+    slab *slabs; /**< All slabs of the pool. */
+    free_obj *free_list; /**< Free objects, which are not cached by any thread. */
+    lockstat lock; /**< Protects slabs and free_list. */
+    unsigned long serial; /**< Unique number of the pool, to tell it apart from destroyed pools. */
+    int slot; /**< Index of the per-thread cache of this pool, or -1 if it has none. */
+};
+
+/**
+* @brief Cache of free objects of one pool in one thread
+*
+*/
+typedef struct pool_cache {
+    unsigned long serial; /**< Serial of the pool, the cached objects belong to. */
+    int count; /**< Number of cached objects. */
+    void *objs[POOL_CACHE_SIZE]; /**< The cached objects. */
+} pool_cache;
+
+/**
+* @brief Per-thread caches, one for every slot
+*
+*/
+static __thread pool_cache caches[POOL_MAX_CACHED];
+
+/**
+* @brief Serial of the live pool owning a slot, 0 if the slot is unused
+*
+*/
+static unsigned long slot_serials[POOL_MAX_CACHED];
+
+/**
+* @brief Serial for the next created pool
+*
+*/
+static unsigned long next_serial = 1;
+
+/**
+* @brief Protects slot_serials and next_serial
+*
+*/
+static pthread_mutex_t slots_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+* @brief Adds a slab to the pool
+* @param pool* Pointer to structure to work on
+* @param size_t Number of objects in the slab
+*
+* The caller has to hold the lock of the pool.
+*
+* */
+static void add_slab(pool *p, size_t n) {
+    size_t header = (sizeof(slab) + POOL_ALIGN - 1) / POOL_ALIGN * POOL_ALIGN;
+    slab *s = (slab *) malloc(header + n * p->objsize);
+    s->next = p->slabs;
+    p->slabs = s;
+    char *obj = (char *) s + header;
+    for (size_t i = 0; i < n; ++i, obj += p->objsize) {
+        free_obj *f = (free_obj *) obj;
+        f->next = p->free_list;
+        p->free_list = f;
+    }
+}
+
+/**
+* @brief Takes an object from the free list
+* @param pool* Pointer to structure to work on
+* @return A free object
+*
+* The caller has to hold the lock of the pool.
+*
+* */
+static void *take_free(pool *p) {
+    if (p->free_list == NULL)
+        add_slab(p, p->slab_objs);
+    free_obj *f = p->free_list;
+    p->free_list = f->next;
+    return f;
+}
+
+/**
+* @brief Puts an object into the free list
+* @param pool* Pointer to structure to work on
+* @param void* The object
+*
+* The caller has to hold the lock of the pool.
+*
+* */
+static void put_free(pool *p, void *obj) {
+    free_obj *f = (free_obj *) obj;
+    f->next = p->free_list;
+    p->free_list = f;
+}
+
+/**
+* @brief Gets the cache of the current thread for a pool
+* @param pool* Pointer to structure to work on
+* @return The cache, or NULL if the pool has no cache in this thread
+*
+* A cache left over from a destroyed pool is taken over. A cache, which still holds objects of another live pool, is
+* not touched.
+*
+* */
+static pool_cache *get_cache(pool *p) {
+    if (p->slot < 0)
+        return NULL;
+    pool_cache *c = &caches[p->slot];
+    if (c->serial == p->serial)
+        return c;
+    if (c->count > 0 && __atomic_load_n(&slot_serials[p->slot], __ATOMIC_ACQUIRE) == c->serial)
+        return NULL;
+    c->serial = p->serial;
+    c->count = 0;
+    return c;
+}
+
+pool *pool_init(size_t objsize, size_t capacity) {
+    pool *p = (pool *) malloc(sizeof(pool));
+    if (objsize < sizeof(free_obj))
+        objsize = sizeof(free_obj);
+    p->objsize = (objsize + POOL_ALIGN - 1) / POOL_ALIGN * POOL_ALIGN;
+    p->slab_objs = capacity > 0 ? capacity : POOL_CACHE_SIZE;
+    p->slabs = NULL;
+    p->free_list = NULL;
+    lockstat_init(&p->lock, "pool");
+
+    /* find a free slot for the per-thread caches */
+    pthread_mutex_lock(&slots_lock);
+    p->serial = next_serial++;
+    p->slot = -1;
+    for (int i = 0; i < POOL_MAX_CACHED; ++i) {
+        if (slot_serials[i] == 0) {
+            p->slot = i;
+            __atomic_store_n(&slot_serials[i], p->serial, __ATOMIC_RELEASE);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&slots_lock);
+
+    if (capacity > 0)
+        add_slab(p, capacity);
+    return p;
+}
+
+void pool_reserve(pool *p, size_t n) {
+    lockstat_lock(&p->lock);
+    add_slab(p, n);
+    lockstat_unlock(&p->lock);
+}
+
+void *pool_alloc(pool *p) {
+    pool_cache *c = get_cache(p);
+    if (c == NULL) {
+        lockstat_lock(&p->lock);
+        void *obj = take_free(p);
+        lockstat_unlock(&p->lock);
+        return obj;
+    }
+    if (c->count == 0) {
+        /* refill half of the cache */
+        lockstat_lock(&p->lock);
+        while (c->count < POOL_CACHE_SIZE / 2)
+            c->objs[c->count++] = take_free(p);
+        lockstat_unlock(&p->lock);
+    }
+    return c->objs[--c->count];
+}
+
+void pool_free(pool *p, void *obj) {
+    pool_cache *c = get_cache(p);
+    if (c == NULL) {
+        lockstat_lock(&p->lock);
+        put_free(p, obj);
+        lockstat_unlock(&p->lock);
+        return;
+    }
+    if (c->count == POOL_CACHE_SIZE) {
+        /* give half of the cache back */
+        lockstat_lock(&p->lock);
+        while (c->count > POOL_CACHE_SIZE / 2)
+            put_free(p, c->objs[--c->count]);
+        lockstat_unlock(&p->lock);
+    }
+    c->objs[c->count++] = obj;
+}
+
+void pool_destroy(pool *p) {
+    if (p->slot >= 0) {
+        pthread_mutex_lock(&slots_lock);
+        __atomic_store_n(&slot_serials[p->slot], 0, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&slots_lock);
+        /* the cache of the calling thread can be dropped right away */
+        if (caches[p->slot].serial == p->serial)
+            caches[p->slot].count = 0;
+    }
+    while (p->slabs) {
+        slab *s = p->slabs;
+        p->slabs = s->next;
+        free(s);
+    }
+    lockstat_destroy(&p->lock);
+    free(p);
+}
@@ -0,0 +1,81 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file pool.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible object pool methods.
+ *
+ * An object pool hands out objects of a fixed size from preallocated slabs. Freed objects are kept for reuse, so after
+ * the pool has been sized for the working set, allocating and freeing objects never touches the heap. Every thread
+ * keeps a small cache of free objects, so most calls do not take the pool's lock either.
+ *
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+/**
+ * @brief Forward declaration for pool
+ *
+ * */
+typedef struct pool pool;
+
+/**
+ * @brief constructor for pool
+ * @param size_t Size of the objects in bytes
+ * @param size_t Number of objects to preallocate
+ * @return A pointer to the pool structure, representing the created object
+ *
+ * After using this structure, it must be freed with pool_destroy(pool *)
+ *
+ * */
+pool *pool_init(size_t, size_t);
+
+/**
+ * @brief Adds room for more objects to the pool
+ * @param pool* Pointer to structure to work on
+ * @param size_t Number of objects to preallocate in addition
+ *
+ * It is thread safe.
+ *
+ * */
+void pool_reserve(pool *, size_t);
+
+/**
+ * @brief Takes an object from the pool
+ * @param pool* Pointer to structure to work on
+ * @return A pointer to an uninitialized object, which must be given back with pool_free()
+ *
+ * If the pool is exhausted, it grows by another slab of the initial size. It is thread safe.
+ *
+ * */
+void *pool_alloc(pool *);
+
+/**
+ * @brief Gives an object back to the pool
+ * @param pool* Pointer to structure to work on
+ * @param void* The object, which must have been taken from the same pool
+ *
+ * It is thread safe.
+ *
+ * */
+void pool_free(pool *, void *);
+
+/**
+ * @brief Destructor for pool
+ * @param pool* Pointer to structure to be freed
+ *
+ * All objects of the pool are freed, whether they were given back or not.
+ *
+ * */
+void pool_destroy(pool *);
+
+#endif /* POOL_H */
@@ -0,0 +1,79 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file ring.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods for ring class.
+ *
+ * The producer only writes tail and the consumer only writes head. Both counters grow monotonically and are masked
+ * to index the buffer. They are kept on separate cache lines, so that producer and consumer do not slow each other
+ * down.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "ring.h"
+
+/**
+* @brief Size of a cache line in bytes
+*
+*/
+#define CACHE_LINE 64
+
+/**
+* @brief Ring structure for representing an instance of a ring buffer
+*
+*/
+struct ring {
+    size_t recsize; /**< Size of a record in bytes. */
+    size_t mask; /**< Capacity of the ring minus one. */
+    char *buf; /**< Storage for the records. */
+    char pad0[CACHE_LINE]; /**< Keeps head on its own cache line. */
+    size_t head; /**< Number of records ever popped, written by the consumer. */
+    char pad1[CACHE_LINE]; /**< Keeps tail on its own cache line. */
+    size_t tail; /**< Number of records ever pushed, written by the producer. */
+    char pad2[CACHE_LINE]; /**< Keeps tail away from following allocations. */
+};
+
+ring *ring_init(size_t recsize, size_t capacity) {
+    ring *r = (ring *) malloc(sizeof(ring));
+    size_t n = 1;
+    while (n < capacity)
+        n <<= 1;
+    r->recsize = recsize;
+    r->mask = n - 1;
+    r->buf = (char *) malloc(n * recsize);
+    r->head = 0;
+    r->tail = 0;
+    return r;
+}
+
+bool ring_push(ring *r, const void *rec) {
+    size_t t = r->tail;
+    if (t - __atomic_load_n(&r->head, __ATOMIC_ACQUIRE) > r->mask)
+        return false;
+    memcpy(r->buf + (t & r->mask) * r->recsize, rec, r->recsize);
+    __atomic_store_n(&r->tail, t + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool ring_pop(ring *r, void *rec) {
+    size_t h = r->head;
+    if (h == __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE))
+        return false;
+    memcpy(rec, r->buf + (h & r->mask) * r->recsize, r->recsize);
+    __atomic_store_n(&r->head, h + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void ring_destroy(ring *r) {
+    free(r->buf);
+    free(r);
+}
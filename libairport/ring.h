@@ -0,0 +1,70 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file ring.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible ring buffer methods.
+ *
+ * A ring is a bounded lock-free queue of fixed-size records for exactly one producer thread and one consumer thread.
+ *
+ */
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Forward declaration for ring
+ *
+ * */
+typedef struct ring ring;
+
+/**
+ * @brief constructor for ring
+ * @param size_t Size of a record in bytes
+ * @param size_t Minimum number of records the ring can hold, is rounded up to a power of two
+ * @return A pointer to the ring structure, representing the created object
+ *
+ * After using this structure, it must be freed with ring_destroy(ring *)
+ *
+ * */
+ring *ring_init(size_t, size_t);
+
+/**
+ * @brief Appends a record to the ring
+ * @param ring* Pointer to structure to work on
+ * @param void* The record to copy into the ring
+ * @return False, if the ring is full, true otherwise
+ *
+ * Must only be called by the producer thread. It never blocks.
+ *
+ * */
+bool ring_push(ring *, const void *);
+
+/**
+ * @brief Removes the oldest record from the ring
+ * @param ring* Pointer to structure to work on
+ * @param void* Buffer the record is copied to
+ * @return False, if the ring is empty, true otherwise
+ *
+ * Must only be called by the consumer thread. It never blocks.
+ *
+ * */
+bool ring_pop(ring *, void *);
+
+/**
+ * @brief Destructor for ring
+ * @param ring* Pointer to structure to be freed
+ *
+ * */
+void ring_destroy(ring *);
+
+#endif /* RING_H */
@@ -0,0 +1,164 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file stats.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the statistics methods.
+ *
+ * Each thread gets its own counters and histograms on first use. They are linked into a list, so that readers can
+ * merge them, and are kept after the thread exits, until stats_destroy().
+ *
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stats.h"
+
+/**
+ * @brief Size of a cache line in bytes
+ *
+ * */
+#define CACHE_LINE 64
+
+/**
+ * @brief Counters and histograms of one thread, linked into the list of all threads
+ *
+ * */
+typedef struct stats_local {
+    unsigned long counters[STATS_NUM_COUNTERS]; /**< Operation counters, written by the thread only. */
+    histogram *times[STATS_NUM_TIMES]; /**< Histograms, created on the first value, NULL before. */
+    struct stats_local *next; /**< Next registered thread. */
+} stats_local;
+
+/**
+ * @brief Names of the recorded times
+ *
+ * */
+static const char *time_names[STATS_NUM_TIMES] = {
+    [STATS_BAY_WAIT] = "bay_wait",
+    [STATS_PLANE_WAIT] = "plane_wait",
+    [STATS_RUNWAY_WAIT] = "runway_wait",
+    [STATS_TURNAROUND] = "turnaround"
+};
+
+/**
+ * @brief Counters and histograms of all threads
+ *
+ * */
+static stats_local *locals = NULL;
+
+/**
+ * @brief Protects the registration of threads
+ *
+ * */
+static pthread_mutex_t locals_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Incremented by every stats_destroy(), so that threads notice their counters are gone
+ *
+ * */
+static unsigned long generation = 0;
+
+/**
+ * @brief Counters and histograms of the current thread
+ *
+ * */
+static __thread stats_local *local = NULL;
+
+/**
+ * @brief Generation of the statistics, local belongs to
+ *
+ * */
+static __thread unsigned long local_generation = 0;
+
+/**
+ * @brief Gets the counters and histograms of the calling thread, and creates them on first use
+ * @return The counters and histograms of the calling thread
+ *
+ * They start on a cache line of their own, so that threads do not slow each other down.
+ *
+ * */
+static stats_local *get_local() {
+    if (local != NULL && local_generation == generation)
+        return local;
+    void *mem;
+    if (posix_memalign(&mem, CACHE_LINE, sizeof(stats_local) + CACHE_LINE) != 0)
+        abort();
+    stats_local *sl = (stats_local *) memset(mem, 0, sizeof(stats_local));
+    pthread_mutex_lock(&locals_lock);
+    sl->next = locals;
+    __atomic_store_n(&locals, sl, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&locals_lock);
+    local = sl;
+    local_generation = generation;
+    return sl;
+}
+
+void stats_count(int counter) {
+    stats_local *sl = get_local();
+    __atomic_store_n(&sl->counters[counter], sl->counters[counter] + 1, __ATOMIC_RELAXED);
+}
+
+void stats_record(int what, time_t ms) {
+    stats_local *sl = get_local();
+    if (sl->times[what] == NULL)
+        __atomic_store_n(&sl->times[what], histogram_init(), __ATOMIC_RELEASE);
+    histogram_record(sl->times[what], ms);
+}
+
+unsigned long stats_get_count(int counter) {
+    unsigned long n = 0;
+    for (stats_local *sl = __atomic_load_n(&locals, __ATOMIC_ACQUIRE); sl != NULL; sl = sl->next)
+        n += __atomic_load_n(&sl->counters[counter], __ATOMIC_RELAXED);
+    return n;
+}
+
+histogram *stats_get_histogram(int what) {
+    histogram *h = histogram_init();
+    for (stats_local *sl = __atomic_load_n(&locals, __ATOMIC_ACQUIRE); sl != NULL; sl = sl->next) {
+        histogram *t = __atomic_load_n(&sl->times[what], __ATOMIC_ACQUIRE);
+        if (t != NULL)
+            histogram_merge(h, t);
+    }
+    return h;
+}
+
+const char *stats_get_name(int what) {
+    return time_names[what];
+}
+
+char *stats_to_string() {
+    size_t size = 128 * (STATS_NUM_TIMES + 1);
+    char *c = malloc(size);
+    size_t len = snprintf(c, size, "%-12s %10s %10s %10s %10s %10s %10s\n", "time [ms]", "count", "p50", "p99",
+                          "p99.9", "p99.99", "max");
+    for (int i = 0; i < STATS_NUM_TIMES; ++i) {
+        histogram *h = stats_get_histogram(i);
+        len += snprintf(c + len, size - len, "%-12s %10lu %10ld %10ld %10ld %10ld %10ld\n", time_names[i],
+                        histogram_count(h), histogram_percentile(h, 50), histogram_percentile(h, 99),
+                        histogram_percentile(h, 99.9), histogram_percentile(h, 99.99), histogram_max(h));
+        histogram_destroy(h);
+    }
+    return c;
+}
+
+void stats_destroy() {
+    pthread_mutex_lock(&locals_lock);
+    while (locals) {
+        stats_local *sl = locals;
+        locals = sl->next;
+        for (int i = 0; i < STATS_NUM_TIMES; ++i)
+            histogram_destroy(sl->times[i]);
+        free(sl);
+    }
+    generation++;
+    pthread_mutex_unlock(&locals_lock);
+}
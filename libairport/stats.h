@@ -0,0 +1,106 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file stats.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible statistics methods.
+ *
+ * The statistics count finished operations and record how long planes wait for bays, parked planes and runways, and
+ * how long they stay parked. All times are taken from current_timestamp(), so they are virtual in the discrete-event
+ * simulation. Every thread records into its own counters and histograms, which are merged when they are read, so
+ * recording is lock free and never shares a cache line with other threads.
+ *
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <time.h>
+#include "histogram.h"
+
+/**
+ * @brief Recorded times
+ *
+ * */
+enum {
+    STATS_BAY_WAIT, /**< Time a landing plane waited for a free bay. */
+    STATS_PLANE_WAIT, /**< Time a take-off waited for a parked plane. */
+    STATS_RUNWAY_WAIT, /**< Time a landing or take-off waited for a free runway. */
+    STATS_TURNAROUND, /**< Time a plane was parked, from parking until it left its bay for take-off. */
+    STATS_NUM_TIMES /**< Number of recorded times. */
+};
+
+/**
+ * @brief Counted operations
+ *
+ * */
+enum {
+    STATS_LANDINGS, /**< Planes parked after landing. */
+    STATS_TAKEOFFS, /**< Planes departed. */
+    STATS_TIMEOUTS, /**< Operations given up after waiting too long. */
+    STATS_NUM_COUNTERS /**< Number of counters. */
+};
+
+/**
+ * @brief Counts an operation
+ * @param int Counter, one of STATS_LANDINGS, STATS_TAKEOFFS or STATS_TIMEOUTS
+ *
+ * */
+void stats_count(int);
+
+/**
+ * @brief Records a time
+ * @param int What was measured, one of STATS_BAY_WAIT, STATS_PLANE_WAIT, STATS_RUNWAY_WAIT or STATS_TURNAROUND
+ * @param time_t The time in milliseconds
+ *
+ * */
+void stats_record(int, time_t);
+
+/**
+ * @brief Gets the value of a counter
+ * @param int The counter
+ * @return Number of counted operations
+ *
+ * */
+unsigned long stats_get_count(int);
+
+/**
+ * @brief Gets all recorded values of a time
+ * @param int What was measured
+ * @return A histogram with the values of all threads. Has to be freed by caller with histogram_destroy().
+ *
+ * Values recorded while merging may be missing.
+ *
+ * */
+histogram *stats_get_histogram(int);
+
+/**
+ * @brief Gets the name of a time
+ * @param int What was measured
+ * @return The name, in lower case with underscores
+ *
+ * */
+const char *stats_get_name(int);
+
+/**
+ * @brief Creates a printable summary of all recorded times
+ * @return A pointer to the summary with percentiles of every time. Has to be freed by caller.
+ *
+ * */
+char *stats_to_string();
+
+/**
+ * @brief Frees the counters and histograms of all threads
+ *
+ * Must not be called while other threads record. Threads record into new counters afterwards.
+ *
+ * */
+void stats_destroy();
+
+#endif /* STATS_H */
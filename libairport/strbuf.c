@@ -0,0 +1,92 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file strbuf.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods for the string buffer class.
+ *
+ */
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include "strbuf.h"
+
+/**
+ * @brief Initial capacity of a buffer in bytes
+ *
+ * */
+#define STRBUF_INITIAL_SIZE 256
+
+/**
+ * @brief String buffer structure for representing an instance of a string buffer
+ *
+ */
+struct strbuf {
+    char *data; /**< The text, always zero terminated. */
+    size_t len; /**< Length of the text. */
+    size_t size; /**< Allocated size of data. */
+    FILE *out; /**< Stream the text is written to, or NULL if it is collected in memory. */
+};
+
+strbuf *strbuf_init() {
+    strbuf *sb = (strbuf *) malloc(sizeof(strbuf));
+    sb->size = STRBUF_INITIAL_SIZE;
+    sb->data = malloc(sb->size);
+    sb->data[0] = '\0';
+    sb->len = 0;
+    sb->out = NULL;
+    return sb;
+}
+
+strbuf *strbuf_init_stream(FILE *out) {
+    strbuf *sb = strbuf_init();
+    sb->out = out;
+    return sb;
+}
+
+void strbuf_printf(strbuf *sb, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(sb->data + sb->len, sb->size - sb->len, format, args);
+    va_end(args);
+    if (n < 0)
+        return;
+    if (sb->len + n >= sb->size) {
+        /* did not fit, grow at least by half, so that appending stays linear */
+        while (sb->len + n >= sb->size)
+            sb->size += sb->size / 2;
+        sb->data = realloc(sb->data, sb->size);
+        va_start(args, format);
+        vsnprintf(sb->data + sb->len, sb->size - sb->len, format, args);
+        va_end(args);
+    }
+    sb->len += n;
+}
+
+void strbuf_flush(strbuf *sb) {
+    if (sb->out == NULL || sb->len == 0)
+        return;
+    fwrite(sb->data, 1, sb->len, sb->out);
+    sb->len = 0;
+    sb->data[0] = '\0';
+}
+
+char *strbuf_release(strbuf *sb) {
+    char *c = sb->data;
+    free(sb);
+    return c;
+}
+
+void strbuf_destroy(strbuf *sb) {
+    strbuf_flush(sb);
+    if (sb->out != NULL)
+        fflush(sb->out);
+    free(sb->data);
+    free(sb);
+}
@@ -0,0 +1,86 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file strbuf.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible string buffer methods.
+ *
+ * A string buffer appends formatted text in amortized linear time. It either collects the whole text in memory, or
+ * streams it to a file: then strbuf_flush() writes out what has been appended so far and empties the buffer, so that
+ * long output never needs a full intermediate copy.
+ *
+ */
+
+#ifndef STRBUF_H
+#define STRBUF_H
+
+#include <stdio.h>
+
+/**
+ * @brief Forward declaration for strbuf
+ *
+ * */
+typedef struct strbuf strbuf;
+
+/**
+ * @brief constructor for a string buffer collecting text in memory
+ * @return A pointer to the strbuf structure, representing the created object
+ *
+ * After using this structure, it must be freed with strbuf_release(strbuf *) or strbuf_destroy(strbuf *)
+ *
+ * */
+strbuf *strbuf_init();
+
+/**
+ * @brief constructor for a string buffer streaming text to a file
+ * @param FILE* Stream the text is written to
+ * @return A pointer to the strbuf structure, representing the created object
+ *
+ * After using this structure, it must be freed with strbuf_destroy(strbuf *), which writes out the rest of the text.
+ *
+ * */
+strbuf *strbuf_init_stream(FILE *);
+
+/**
+ * @brief Appends formatted text
+ * @param strbuf* Pointer to structure to work on
+ * @param char* printf() style format
+ *
+ * The buffer grows as needed. Nothing is written to the stream.
+ *
+ * */
+void strbuf_printf(strbuf *, const char *, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Writes the text appended so far to the stream and empties the buffer
+ * @param strbuf* Pointer to structure to work on
+ *
+ * Does nothing for buffers collecting text in memory.
+ *
+ * */
+void strbuf_flush(strbuf *);
+
+/**
+ * @brief Destructor for strbuf, which hands out the collected text
+ * @param strbuf* Pointer to structure to be freed
+ * @return A pointer to the text. Has to be freed by caller.
+ *
+ * */
+char *strbuf_release(strbuf *);
+
+/**
+ * @brief Destructor for strbuf
+ * @param strbuf* Pointer to structure to be freed
+ *
+ * Writes out the rest of the text, if the buffer streams to a file.
+ *
+ * */
+void strbuf_destroy(strbuf *);
+
+#endif /* STRBUF_H */
@@ -0,0 +1,226 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file timesource.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the clock of the simulation.
+ *
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "timesource.h"
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+/**
+ * @brief Time the time stamp counter is calibrated for
+ *
+ * */
+#define TIMESOURCE_CALIBRATION_MS 20
+
+/**
+ * @brief Fixed point shift of the nanoseconds per tick of the time stamp counter
+ *
+ * */
+#define TIMESOURCE_TSC_SHIFT 32
+
+/**
+ * @brief Names of the clocks
+ *
+ * */
+static const char *names[TIMESOURCE_NUM] = {"monotonic", "coarse", "tsc"};
+
+/**
+ * @brief The selected clock
+ *
+ * */
+static int selected = TIMESOURCE_MONOTONIC;
+
+/**
+ * @brief Reads a POSIX clock
+ * @param clockid_t The clock
+ * @return Nanoseconds of the clock
+ *
+ * */
+static inline uint64_t read_clock(clockid_t id) {
+    struct timespec ts;
+    clock_gettime(id, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief Reads CLOCK_MONOTONIC
+ * @return Nanoseconds of the clock
+ *
+ * */
+static uint64_t monotonic_ns() {
+    return read_clock(CLOCK_MONOTONIC);
+}
+
+/**
+ * @brief Reads CLOCK_MONOTONIC_COARSE, or CLOCK_MONOTONIC where there is no coarse clock
+ * @return Nanoseconds of the clock
+ *
+ * */
+static uint64_t coarse_ns() {
+#ifdef CLOCK_MONOTONIC_COARSE
+    return read_clock(CLOCK_MONOTONIC_COARSE);
+#else
+    return read_clock(CLOCK_MONOTONIC);
+#endif
+}
+
+#if defined(__x86_64__)
+
+/**
+ * @brief Value of the time stamp counter at calibration
+ *
+ * */
+static uint64_t tsc_base;
+
+/**
+ * @brief Nanoseconds of CLOCK_MONOTONIC at calibration
+ *
+ * */
+static uint64_t tsc_base_ns;
+
+/**
+ * @brief Nanoseconds per tick of the time stamp counter, shifted by TIMESOURCE_TSC_SHIFT
+ *
+ * */
+static uint64_t tsc_mult;
+
+/**
+ * @brief Reads the time stamp counter
+ * @return Nanoseconds since calibration, plus the time of CLOCK_MONOTONIC at calibration
+ *
+ * */
+static uint64_t tsc_ns() {
+    uint64_t ticks = __builtin_ia32_rdtsc() - tsc_base;
+    return tsc_base_ns + (uint64_t) (((unsigned __int128) ticks * tsc_mult) >> TIMESOURCE_TSC_SHIFT);
+}
+
+/**
+ * @brief Calibrates the time stamp counter
+ * @return True, if the counter ticks at a constant rate and was calibrated, false otherwise
+ *
+ * */
+static bool tsc_calibrate() {
+    /* the counter must not change its rate with the processor's frequency or stop in sleep states */
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || !(edx & (1u << 8)))
+        return false;
+
+    uint64_t start_ns = monotonic_ns();
+    uint64_t start = __builtin_ia32_rdtsc();
+    struct timespec req = {.tv_sec = 0, .tv_nsec = TIMESOURCE_CALIBRATION_MS * 1000000L};
+    nanosleep(&req, NULL);
+    uint64_t ticks = __builtin_ia32_rdtsc() - start;
+    uint64_t ns = monotonic_ns() - start_ns;
+    if (ticks == 0)
+        return false;
+    tsc_mult = (uint64_t) (((unsigned __int128) ns << TIMESOURCE_TSC_SHIFT) / ticks);
+    tsc_base = start;
+    tsc_base_ns = start_ns;
+    return true;
+}
+
+#endif
+
+/**
+ * @brief Reads the selected clock
+ *
+ * */
+static uint64_t (*now_ns)(void) = monotonic_ns;
+
+/**
+ * @brief Factor simulated time runs faster than real time
+ *
+ * */
+static int speed = 1;
+
+/**
+ * @brief Time of the selected clock when the speed was set, simulated time is dilated from there on
+ *
+ * */
+static uint64_t speed_base_ns = 0;
+
+int timesource_parse(const char *name) {
+    for (int i = 0; i < TIMESOURCE_NUM; ++i) {
+        if (!strcmp(name, names[i]))
+            return i;
+    }
+    return -1;
+}
+
+const char *timesource_get_name(int source) {
+    return names[source];
+}
+
+int timesource_select(int source) {
+    selected = TIMESOURCE_MONOTONIC;
+    now_ns = monotonic_ns;
+    if (source == TIMESOURCE_COARSE) {
+        selected = source;
+        now_ns = coarse_ns;
+    }
+#if defined(__x86_64__)
+    if (source == TIMESOURCE_TSC && tsc_calibrate()) {
+        selected = source;
+        now_ns = tsc_ns;
+    }
+#endif
+    return selected;
+}
+
+int timesource_get() {
+    return selected;
+}
+
+uint64_t timesource_now_ns() {
+    return now_ns();
+}
+
+void timesource_set_speed(int factor) {
+    speed_base_ns = now_ns();
+    speed = factor;
+}
+
+int timesource_get_speed() {
+    return speed;
+}
+
+uint64_t timesource_now_ms() {
+    uint64_t ns = now_ns();
+    if (speed != 1)
+        ns = speed_base_ns + (ns - speed_base_ns) * speed;
+    return ns / 1000000;
+}
+
+void timesource_deadline(struct timespec *ts, long long m) {
+    long long ns = m * 1000000LL / speed;
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += ns / 1000000000;
+    ts->tv_nsec += ns % 1000000000;
+    if (ts->tv_nsec >= 1000000000) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000;
+    }
+}
+
+void timesource_cond_init(pthread_cond_t *cond) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file timesource.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the clock of the simulation.
+ *
+ * All timestamps of the simulation, like parking times, log times and lock profiles, come from one clock, which is
+ * selected at startup:
+ *
+ * - monotonic: CLOCK_MONOTONIC, which is not affected by NTP adjustments or changes of the wall clock.
+ * - coarse: CLOCK_MONOTONIC_COARSE, which is only as precise as the kernel tick, but much cheaper to read.
+ * - tsc: the processor's time stamp counter, calibrated against CLOCK_MONOTONIC, read without a system call.
+ *
+ * The discrete-event simulations run on virtual time instead, which each of their threads installs with
+ * set_timestamp_source().
+ *
+ * The realtime simulation can be sped up by a factor, which dilates time: the simulated milliseconds of
+ * timesource_now_ms() pass that many times faster than real ones, and the timed waits and sleeps of the simulation,
+ * whose durations are given in simulated milliseconds, are that many times shorter. The threads and their
+ * interleavings stay real.
+ *
+ * Timed waits cannot wait for any of these clocks. Their deadlines are taken from CLOCK_MONOTONIC, for condition
+ * variables initialized with timesource_cond_init().
+ *
+ */
+
+#ifndef TIMESOURCE_H
+#define TIMESOURCE_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Highest speed factor
+ *
+ * */
+#define TIMESOURCE_MAX_SPEED 10000
+
+/**
+ * @brief Clocks
+ *
+ * */
+enum {
+    TIMESOURCE_MONOTONIC, /**< CLOCK_MONOTONIC. */
+    TIMESOURCE_COARSE, /**< CLOCK_MONOTONIC_COARSE. */
+    TIMESOURCE_TSC, /**< Calibrated time stamp counter. */
+    TIMESOURCE_NUM /**< Number of clocks. */
+};
+
+/**
+ * @brief Converts the name of a clock
+ * @param char* Name of the clock: monotonic, coarse or tsc
+ * @return The clock, or -1 if the name is unknown
+ *
+ * */
+int timesource_parse(const char *);
+
+/**
+ * @brief Gets the name of a clock
+ * @param int The clock
+ * @return Name of the clock
+ *
+ * */
+const char *timesource_get_name(int);
+
+/**
+ * @brief Selects the clock
+ * @param int The clock
+ * @return The selected clock, which is monotonic, if the requested one is not available on this machine
+ *
+ * Has to be called before other threads are started. Selecting the time stamp counter calibrates it, which takes
+ * some milliseconds.
+ *
+ * */
+int timesource_select(int);
+
+/**
+ * @brief Gets the selected clock
+ * @return The selected clock
+ *
+ * */
+int timesource_get();
+
+/**
+ * @brief Reads the selected clock
+ * @return Nanoseconds since an arbitrary point in time, which stays the same while the process runs
+ *
+ * This is real time, which is not sped up, e.g. for profiling.
+ *
+ * */
+uint64_t timesource_now_ns();
+
+/**
+ * @brief Sets the speed of the simulated time
+ * @param int Factor simulated time runs faster than real time, between 1 and TIMESOURCE_MAX_SPEED
+ *
+ * Has to be called after timesource_select() and before other threads are started.
+ *
+ * */
+void timesource_set_speed(int);
+
+/**
+ * @brief Gets the speed of the simulated time
+ * @return Factor simulated time runs faster than real time
+ *
+ * */
+int timesource_get_speed();
+
+/**
+ * @brief Reads the simulated time
+ * @return Milliseconds of the selected clock, sped up by the speed factor
+ *
+ * */
+uint64_t timesource_now_ms();
+
+/**
+ * @brief Computes the deadline of a timed wait
+ * @param timespec* Receives the absolute time on CLOCK_MONOTONIC
+ * @param long-long Simulated milliseconds from now, which are divided by the speed factor
+ *
+ * */
+void timesource_deadline(struct timespec *, long long);
+
+/**
+ * @brief Initializes a condition variable, whose timed waits take deadlines from timesource_deadline()
+ * @param pthread_cond_t* The condition variable
+ *
+ * */
+void timesource_cond_init(pthread_cond_t *);
+
+#endif /* TIMESOURCE_H */
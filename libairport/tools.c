@@ -0,0 +1,180 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file tools.c
+ * @author Lukas Elsner
+ * @date 02-09-2014
+ * @brief File containing functions methods with general purpose
+ *
+ */
+
+#include <time.h>
+#include <stdlib.h>
+#include <string.h>
+#include "timesource.h"
+#include "tools.h"
+
+/**
+* @brief Seed all per-thread random number generators are derived from
+*
+* */
+static uint64_t master_seed = 0;
+
+/**
+* @brief Next stream number for threads, which did not call rng_thread_init()
+*
+* */
+static unsigned int next_anonymous_stream = 1u << 24;
+
+/**
+* @brief State of the xoshiro256** generator of the current thread
+*
+* */
+static __thread uint64_t rng_state[4];
+
+/**
+* @brief True, if the generator of the current thread has been seeded
+*
+* */
+static __thread bool rng_seeded = false;
+
+/**
+* @brief Advances a splitmix64 generator
+* @param uint64_t* State of the generator
+* @return The next output of the generator
+*
+* splitmix64 is used to expand a single seed into the state of xoshiro256**.
+*
+* */
+static uint64_t splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+* @brief Rotates a 64 bit value left
+* @param uint64_t The value
+* @param int Number of bits
+* @return The rotated value
+*
+* */
+static inline uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+void rng_seed(uint64_t seed)
+{
+    master_seed = seed;
+    rng_thread_init(0);
+}
+
+void rng_thread_init(unsigned int stream)
+{
+    uint64_t x = master_seed ^ (0xD1B54A32D192ED03ULL * ((uint64_t)stream + 1));
+    for (int i = 0; i < 4; ++i)
+        rng_state[i] = splitmix64(&x);
+    rng_seeded = true;
+}
+
+void rng_get_state(uint64_t *state)
+{
+    if(!rng_seeded)
+        rng_thread_init(__atomic_fetch_add(&next_anonymous_stream, 1, __ATOMIC_RELAXED));
+    memcpy(state, rng_state, sizeof(rng_state));
+}
+
+void rng_set_state(const uint64_t *state)
+{
+    memcpy(rng_state, state, sizeof(rng_state));
+    rng_seeded = true;
+}
+
+uint64_t rng_next()
+{
+    if(!rng_seeded)
+        rng_thread_init(__atomic_fetch_add(&next_anonymous_stream, 1, __ATOMIC_RELAXED));
+    uint64_t *s = rng_state;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+uint32_t rng_range(uint32_t n)
+{
+    /* multiply-shift maps 32 random bits to [0, n) without a division */
+    return (uint32_t)(((rng_next() >> 32) * (uint64_t)n) >> 32);
+}
+
+double rng_double()
+{
+    /* the upper 53 bits fill the mantissa of a double */
+    return (rng_next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+char *generate_rand(int num_l, int num_n)
+{
+    char *name = (char *)malloc(sizeof(char) * (num_l + num_n + 1));
+    generate_rand_into(name, num_l, num_n);
+    return name;
+}
+
+void generate_rand_into(char *name, int num_l, int num_n)
+{
+    char *c = name;
+    /* generate num_l letters */
+    for (int i = 0; i < num_l; ++i)
+        *(c++) = 'A' + rng_range(26);
+    /* generate num_n numbers */
+    for (int i = 0; i < num_n; ++i)
+        *(c++) = '0' + rng_range(10);
+    *(c++) = 0;
+}
+
+/**
+* @brief Source of current_timestamp() for the current thread, NULL means wall clock.
+*
+* */
+static __thread time_t (*timestamp_source)(void) = NULL;
+
+time_t current_timestamp()
+{
+    if(timestamp_source)
+        return timestamp_source();
+
+    return timesource_now_ms();
+}
+
+void set_timestamp_source(time_t (*source)(void))
+{
+    timestamp_source = source;
+}
+
+bool prob_bool(int prob)
+{
+    /* check if probability is within allowed range */
+    if(prob > 100) prob = 100;
+    if(prob < 0) prob = 0;
+    return rng_range(100) < (uint32_t)prob;
+}
+
+void msleep(long long m)
+{
+    struct timespec req = { .tv_sec = m / 1000, .tv_nsec = 1000000 * (m % 1000) };
+    nanosleep(&req, NULL);
+}
+
@@ -0,0 +1,136 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file tools.h
+ * @author Lukas Elsner
+ * @date 02-09-2014
+ * @brief Header file containing functions methods with general purpose
+ *
+ */
+
+#ifndef TOOLS_H
+#define TOOLS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+* @brief Generates a random name based on num_l letters followed by num_n numbers
+* @return A pointer to a the generated string. Has to be freed by caller.
+*
+* */
+char *generate_rand(int num_l, int num_n);
+
+/**
+* @brief Generates a random name based on num_l letters followed by num_n numbers into a given buffer
+* @param char* Buffer, which must hold at least num_l + num_n + 1 characters
+*
+* */
+void generate_rand_into(char *name, int num_l, int num_n);
+
+/**
+* @brief Get the current timestamp
+* @return The current timestamp in milliseconds.
+*
+* The timestamp is the simulated time of timesource_now_ms(), unless the calling thread has replaced it.
+*
+* */
+time_t current_timestamp();
+
+/**
+* @brief Replaces the source of current_timestamp() for the calling thread
+* @param time_t(*)(void) Function returning the current time in milliseconds, or NULL to use the wall clock again.
+*
+* The discrete-event simulation uses this to let bays measure their occupation in virtual time.
+*
+* */
+void set_timestamp_source(time_t (*)(void));
+
+/**
+ * @brief Boolean generator based on a given probability
+ * @param int A probability value between 0 and 100.
+ * @return A randomly generated boolean value
+ *
+ * Values below 0 will be handled as 0, values above 100 will be handled as 100.
+ *
+ * */
+bool prob_bool(int);
+
+/**
+* @brief Sets the master seed of the random number generators
+* @param uint64_t The master seed
+*
+* Every thread has its own generator, which is derived from the master seed and the stream number passed to
+* rng_thread_init(). The calling thread is seeded as stream 0. This has to be called before other threads are started.
+*
+* */
+void rng_seed(uint64_t);
+
+/**
+* @brief Seeds the random number generator of the calling thread
+* @param unsigned-int Stream number, which has to be unique among all threads
+*
+* Threads using the same master seed and stream number draw the same sequence of numbers. Threads, which never call
+* this, are seeded with an unused stream number on first use.
+*
+* */
+void rng_thread_init(unsigned int);
+
+/**
+* @brief Copies the state of the random number generator of the calling thread
+* @param uint64_t* Receives the state, four words
+*
+* Together with rng_set_state(), this lets a thread switch between several generators, e.g. one per simulated airport.
+*
+* */
+void rng_get_state(uint64_t *);
+
+/**
+* @brief Replaces the state of the random number generator of the calling thread
+* @param uint64_t* The state, four words, taken from rng_get_state()
+*
+* */
+void rng_set_state(const uint64_t *);
+
+/**
+* @brief Draws a random number from the generator of the calling thread
+* @return A uniformly distributed 64 bit random number
+*
+* The generator is xoshiro256**, which is fast and not shared between threads, so this never blocks.
+*
+* */
+uint64_t rng_next();
+
+/**
+* @brief Draws a random number in a range from the generator of the calling thread
+* @param uint32_t Upper bound, must be greater than 0
+* @return A uniformly distributed random number between 0 and the upper bound (exclusive)
+*
+* */
+uint32_t rng_range(uint32_t);
+
+/**
+* @brief Draws a random floating point number from the generator of the calling thread
+* @return A uniformly distributed random number between 0 and 1 (exclusive)
+*
+* */
+double rng_double();
+
+/**
+* @brief Sleep function with milliseconds granularity
+* @param long-long The time in milliseconds
+*
+* The current thread will block for the given time in milliseconds.
+* This is implemented with help of the POSIX nanosleep function and a timespec struct.
+*
+*
+* */
+void msleep(long long);
+
+#endif /* TOOLS_H */
\ No newline at end of file
@@ -0,0 +1,367 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file trace.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the recording and reading of event traces.
+ *
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "tools.h"
+#include "trace.h"
+#include "wire.h"
+
+/**
+ * @brief Magic number at the start of a trace file, including the terminating zero byte
+ *
+ * */
+#define TRACE_MAGIC "ASTRACE"
+
+/**
+ * @brief Version of the file format
+ *
+ * */
+#define TRACE_VERSION 1
+
+/**
+ * @brief Size of the file header in bytes
+ *
+ * */
+#define TRACE_HEADER_SIZE 48
+
+/**
+ * @brief Number of events, which can be recorded before the oldest one is written
+ *
+ * */
+#define TRACE_WINDOW 65536
+
+/**
+ * @brief Size of the chunks written to the file in bytes
+ *
+ * */
+#define TRACE_CHUNK_SIZE 65536
+
+/**
+ * @brief Time the writer sleeps, when there is no event to write, in milliseconds
+ *
+ * */
+#define TRACE_IDLE_MS 1
+
+/**
+ * @brief An event in memory, before it is written
+ *
+ * */
+typedef struct raw_event {
+    unsigned long ready; /**< Global number of the event plus one, once it is complete. */
+    time_t time; /**< Timestamp of the event. */
+    int type; /**< Type of the event. */
+    int id; /**< Number of the bay or runway. */
+    int runway; /**< For park events, the runway the plane landed on. */
+    char name[8]; /**< For park events, the name of the plane. */
+} raw_event;
+
+/**
+ * @brief Trace reader structure for representing an instance of a mapped trace file
+ *
+ */
+struct trace_reader {
+    uint8_t *data; /**< The mapped file. */
+    size_t size; /**< Size of the file. */
+    const uint8_t *pos; /**< Position of the next event. */
+    int num_bays; /**< Number of bays of the traced airport. */
+    int num_runways; /**< Number of runways of the traced airport. */
+    uint64_t seed; /**< Master seed of the traced run. */
+    unsigned long count; /**< Number of events. */
+    unsigned long read; /**< Number of events read so far. */
+    time_t time; /**< Timestamp of the previous event. */
+};
+
+/**
+ * @brief Events are recorded
+ *
+ * */
+static bool enabled = false;
+
+/**
+ * @brief Number of the next event
+ *
+ * */
+static unsigned long next_seq = 0;
+
+/**
+ * @brief Number of events written, the writer's position in the window
+ *
+ * */
+static unsigned long written = 0;
+
+/**
+ * @brief Events, which are recorded but not written yet, event n is in slot n % TRACE_WINDOW
+ *
+ * */
+static raw_event *window = NULL;
+
+/**
+ * @brief The trace file
+ *
+ * */
+static FILE *file = NULL;
+
+/**
+ * @brief Header of the trace file, rewritten with every chunk
+ *
+ * */
+static uint8_t header[TRACE_HEADER_SIZE];
+
+/**
+ * @brief Encoded events, which are not in the file yet
+ *
+ * */
+static uint8_t chunk[TRACE_CHUNK_SIZE];
+
+/**
+ * @brief Number of bytes in chunk
+ *
+ * */
+static size_t chunk_len = 0;
+
+/**
+ * @brief Timestamp of the last written event
+ *
+ * */
+static time_t prev_time = 0;
+
+/**
+ * @brief A write to the file failed
+ *
+ * */
+static bool failed = false;
+
+/**
+ * @brief Tells the writer to write the remaining events and stop
+ *
+ * */
+static bool stopping = false;
+
+/**
+ * @brief Thread writing the events to the file
+ *
+ * */
+static pthread_t writer;
+
+/**
+ * @brief Writes the encoded events and the header, which counts them, to the file
+ *
+ * The file holds a valid trace of all events written so far afterwards, also if the process dies later.
+ *
+ * */
+static void flush_chunk() {
+    if (chunk_len > 0 && fwrite(chunk, 1, chunk_len, file) != chunk_len)
+        failed = true;
+    chunk_len = 0;
+    wire_put_u64(header + 24, written);
+    long end = ftell(file);
+    if (fseek(file, 0, SEEK_SET) != 0 || fwrite(header, 1, sizeof(header), file) != sizeof(header) ||
+        fseek(file, end, SEEK_SET) != 0 || fflush(file) != 0)
+        failed = true;
+}
+
+/**
+ * @brief Encodes an event after the previous one
+ * @param raw_event* The event
+ *
+ * */
+static void encode_event(raw_event *e) {
+    if (chunk_len + 3 * WIRE_VARINT_MAX + 2 + sizeof(e->name) > sizeof(chunk))
+        flush_chunk();
+    if (written == 0) {
+        wire_put_u64(header + 32, e->time);
+        prev_time = e->time;
+    }
+    uint8_t *buf = chunk + chunk_len;
+    size_t len = 0;
+    buf[len++] = (uint8_t) e->type;
+    len += wire_put_varint(buf + len, wire_zigzag(e->time - prev_time));
+    len += wire_put_varint(buf + len, e->id);
+    if (e->type == TRACE_PARK) {
+        size_t name_len = strlen(e->name);
+        len += wire_put_varint(buf + len, e->runway);
+        buf[len++] = (uint8_t) name_len;
+        memcpy(buf + len, e->name, name_len);
+        len += name_len;
+    }
+    chunk_len += len;
+    prev_time = e->time;
+}
+
+/**
+ * @brief Writer thread
+ *
+ * Writes the events in the order of their numbers, as soon as all events before them are complete. When there is
+ * nothing to write, the encoded events go to the file, so that little is lost if the process dies.
+ *
+ * */
+static void *writer_thread_func(void *arg) {
+    (void) arg;
+    for (;;) {
+        raw_event *e = &window[written % TRACE_WINDOW];
+        if (__atomic_load_n(&e->ready, __ATOMIC_ACQUIRE) == written + 1) {
+            encode_event(e);
+            /* the slot can be used again */
+            __atomic_store_n(&written, written + 1, __ATOMIC_RELEASE);
+            continue;
+        }
+        bool stop = __atomic_load_n(&stopping, __ATOMIC_ACQUIRE);
+        if (chunk_len > 0)
+            flush_chunk();
+        /* no event is recorded once stopping is set, so all of them are written */
+        if (stop && written == __atomic_load_n(&next_seq, __ATOMIC_RELAXED))
+            return NULL;
+        msleep(TRACE_IDLE_MS);
+    }
+}
+
+bool trace_start(const char *path, int num_bays, int num_runways, uint64_t seed) {
+    file = fopen(path, "wb");
+    if (file == NULL)
+        return false;
+    memset(header, 0, sizeof(header));
+    memcpy(header, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    wire_put_u32(header + 8, TRACE_VERSION);
+    wire_put_u32(header + 12, num_bays);
+    wire_put_u32(header + 16, num_runways);
+    wire_put_u64(header + 40, seed);
+    failed = fwrite(header, 1, sizeof(header), file) != sizeof(header);
+    window = (raw_event *) calloc(TRACE_WINDOW, sizeof(raw_event));
+    next_seq = 0;
+    written = 0;
+    chunk_len = 0;
+    stopping = false;
+    pthread_create(&writer, NULL, writer_thread_func, NULL);
+    enabled = true;
+    return true;
+}
+
+bool trace_enabled() {
+    return enabled;
+}
+
+void trace_event(int type, int id, int runway, const char *name) {
+    if (!enabled)
+        return;
+    unsigned long seq = __atomic_fetch_add(&next_seq, 1, __ATOMIC_RELAXED);
+    /* the slot is free, once the writer has written the event a window before */
+    while (seq - __atomic_load_n(&written, __ATOMIC_ACQUIRE) >= TRACE_WINDOW)
+        sched_yield();
+    raw_event *e = &window[seq % TRACE_WINDOW];
+    e->time = current_timestamp();
+    e->type = type;
+    e->id = id;
+    e->runway = runway;
+    memset(e->name, 0, sizeof(e->name));
+    if (type == TRACE_PARK && name != NULL)
+        strncpy(e->name, name, sizeof(e->name) - 1);
+    __atomic_store_n(&e->ready, seq + 1, __ATOMIC_RELEASE);
+}
+
+bool trace_stop() {
+    enabled = false;
+    __atomic_store_n(&stopping, true, __ATOMIC_RELEASE);
+    pthread_join(writer, NULL);
+    free(window);
+    window = NULL;
+    bool ok = !failed && !ferror(file);
+    ok = fclose(file) == 0 && ok;
+    file = NULL;
+    return ok;
+}
+
+trace_reader *trace_reader_init(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < TRACE_HEADER_SIZE) {
+        close(fd);
+        return NULL;
+    }
+    uint8_t *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return NULL;
+    if (memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 || wire_get_u32(data + 8) != TRACE_VERSION) {
+        munmap(data, st.st_size);
+        return NULL;
+    }
+    trace_reader *r = (trace_reader *) malloc(sizeof(trace_reader));
+    r->data = data;
+    r->size = st.st_size;
+    r->num_bays = wire_get_u32(data + 12);
+    r->num_runways = wire_get_u32(data + 16);
+    r->count = wire_get_u64(data + 24);
+    r->time = wire_get_u64(data + 32);
+    r->seed = wire_get_u64(data + 40);
+    r->read = 0;
+    r->pos = data + TRACE_HEADER_SIZE;
+    return r;
+}
+
+int trace_reader_get_num_bays(trace_reader *r) {
+    return r->num_bays;
+}
+
+int trace_reader_get_num_runways(trace_reader *r) {
+    return r->num_runways;
+}
+
+uint64_t trace_reader_get_seed(trace_reader *r) {
+    return r->seed;
+}
+
+unsigned long trace_reader_get_count(trace_reader *r) {
+    return r->count;
+}
+
+bool trace_reader_next(trace_reader *r, trace_record *rec) {
+    const uint8_t *end = r->data + r->size;
+    const uint8_t *p = r->pos;
+    uint64_t delta, id, runway = 0;
+    if (r->read == r->count || p >= end)
+        return false;
+    rec->type = *p++;
+    if (rec->type >= TRACE_NUM_EVENTS || !wire_get_varint(&p, end, &delta) || !wire_get_varint(&p, end, &id))
+        return false;
+    memset(rec->name, 0, sizeof(rec->name));
+    if (rec->type == TRACE_PARK) {
+        if (!wire_get_varint(&p, end, &runway) || p >= end || *p >= sizeof(rec->name) || end - p - 1 < *p)
+            return false;
+        memcpy(rec->name, p + 1, *p);
+        p += 1 + *p;
+    }
+    r->time += wire_unzigzag(delta);
+    rec->time = r->time;
+    rec->id = (int) id;
+    rec->runway = (int) runway;
+    r->pos = p;
+    r->read++;
+    return true;
+}
+
+void trace_reader_destroy(trace_reader *r) {
+    munmap(r->data, r->size);
+    free(r);
+}
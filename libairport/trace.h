@@ -0,0 +1,169 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file trace.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible methods of the event trace.
+ *
+ * The trace records every change of the state of an airport: bays being reserved, parked in, unparked and released,
+ * and runways being taken and freed. Events are numbered by a global counter, which is taken while the changed bay or
+ * runway is held, so that the order of events on a bay or runway is the order they happened in. A writer thread
+ * writes them in this order to a binary file, in chunks while the run goes on, and keeps the header up to date. So the
+ * memory of the trace is bounded, and the file holds a readable trace of all but the latest events, if the process
+ * dies.
+ *
+ * The file is meant to be mapped into memory and read from front to back. It starts with a 48 byte header: "ASTRACE"
+ * and a zero byte, the format version, number of bays and runways and a zero as 32 bit numbers, and the number of
+ * events, the timestamp of the first event and the master seed as 64 bit numbers, all little-endian. Every event
+ * follows as its type in one byte, the time since the previous event as zigzag encoded variable-length integer, and the
+ * number of the bay or runway as variable-length integer. A park event adds the runway as variable-length integer and
+ * the name of the plane, as length in one byte followed by its characters.
+ *
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Types of traced events
+ *
+ * */
+enum {
+    TRACE_RESERVE, /**< A free bay was reserved for a landing plane. */
+    TRACE_PARK, /**< A plane was parked in a reserved bay. */
+    TRACE_UNPARK, /**< A plane left its bay for take-off, the bay stays reserved. */
+    TRACE_RELEASE, /**< A reserved bay became free. */
+    TRACE_ACQUIRE, /**< A runway was taken. */
+    TRACE_FREE, /**< A runway was freed. */
+    TRACE_NUM_EVENTS /**< Number of event types. */
+};
+
+/**
+ * @brief An event read from a trace file
+ *
+ * */
+typedef struct trace_record {
+    int type; /**< Type of the event. */
+    time_t time; /**< Timestamp of the event in milliseconds. */
+    int id; /**< Number of the bay or runway. */
+    int runway; /**< For park events, the runway the plane landed on. */
+    char name[8]; /**< For park events, the name of the plane. */
+} trace_record;
+
+/**
+ * @brief Forward declaration for trace_reader
+ *
+ * */
+typedef struct trace_reader trace_reader;
+
+/**
+ * @brief Starts recording events
+ * @param char* Path of the file
+ * @param int Number of bays of the traced airport
+ * @param int Number of runways of the traced airport
+ * @param uint64_t Master seed of the run, stored in the file for reference
+ * @return True, if the file has been created, false otherwise
+ *
+ * Starts the writer thread. No event is recorded, if this fails.
+ *
+ * */
+bool trace_start(const char *, int, int, uint64_t);
+
+/**
+ * @brief Checks if events are recorded
+ * @return True between trace_start() and trace_stop()
+ *
+ * */
+bool trace_enabled();
+
+/**
+ * @brief Records an event
+ * @param int Type of the event
+ * @param int Number of the bay or runway
+ * @param int For park events, the runway the plane landed on, ignored otherwise
+ * @param char* For park events, the name of the plane, ignored otherwise
+ *
+ * The timestamp is taken from current_timestamp(). Does nothing, if no trace is recorded. It is thread safe and does
+ * not take any lock, but the caller has to hold the bay or runway. If the writer is too far behind, it waits for it.
+ *
+ * */
+void trace_event(int, int, int, const char *);
+
+/**
+ * @brief Stops recording, writes the remaining events and closes the file
+ * @return True, if all events have been written, false otherwise
+ *
+ * No other thread may record events at the same time.
+ *
+ * */
+bool trace_stop();
+
+/**
+ * @brief constructor for trace_reader
+ * @param char* Path of the trace file, which is mapped into memory
+ * @return A pointer to the trace_reader structure, or NULL if the file cannot be read or is no trace
+ *
+ * After using this structure, it must be freed with trace_reader_destroy(trace_reader *)
+ *
+ * */
+trace_reader *trace_reader_init(const char *);
+
+/**
+ * @brief Gets the number of bays of the traced airport
+ * @param trace_reader* Pointer to structure to work on
+ * @return Number of bays
+ *
+ * */
+int trace_reader_get_num_bays(trace_reader *);
+
+/**
+ * @brief Gets the number of runways of the traced airport
+ * @param trace_reader* Pointer to structure to work on
+ * @return Number of runways
+ *
+ * */
+int trace_reader_get_num_runways(trace_reader *);
+
+/**
+ * @brief Gets the master seed of the traced run
+ * @param trace_reader* Pointer to structure to work on
+ * @return The seed
+ *
+ * */
+uint64_t trace_reader_get_seed(trace_reader *);
+
+/**
+ * @brief Gets the number of events in the trace
+ * @param trace_reader* Pointer to structure to work on
+ * @return Number of events
+ *
+ * */
+unsigned long trace_reader_get_count(trace_reader *);
+
+/**
+ * @brief Reads the next event
+ * @param trace_reader* Pointer to structure to work on
+ * @param trace_record* Receives the event
+ * @return True, if an event was read, false at the end of the trace or if the rest of the file is damaged
+ *
+ * */
+bool trace_reader_next(trace_reader *, trace_record *);
+
+/**
+ * @brief Destructor for trace_reader
+ * @param trace_reader* Pointer to structure to be freed
+ *
+ * */
+void trace_reader_destroy(trace_reader *);
+
+#endif /* TRACE_H */
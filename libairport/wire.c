@@ -0,0 +1,65 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file wire.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods of the binary encoding.
+ *
+ */
+
+#include "wire.h"
+
+size_t wire_put_varint(uint8_t *buf, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        buf[n++] = (uint8_t) (v | 0x80);
+        v >>= 7;
+    }
+    buf[n++] = (uint8_t) v;
+    return n;
+}
+
+bool wire_get_varint(const uint8_t **p, const uint8_t *end, uint64_t *v) {
+    uint64_t x = 0;
+    for (int shift = 0; shift < 7 * WIRE_VARINT_MAX && *p < end; shift += 7) {
+        uint8_t b = *(*p)++;
+        x |= (uint64_t) (b & 0x7f) << shift;
+        if (!(b & 0x80)) {
+            *v = x;
+            return true;
+        }
+    }
+    return false;
+}
+
+void wire_put_u32(uint8_t *buf, uint32_t v) {
+    for (int i = 0; i < 4; ++i)
+        buf[i] = (uint8_t) (v >> (8 * i));
+}
+
+uint32_t wire_get_u32(const uint8_t *buf) {
+    return buf[0] | (uint32_t) buf[1] << 8 | (uint32_t) buf[2] << 16 | (uint32_t) buf[3] << 24;
+}
+
+void wire_put_u64(uint8_t *buf, uint64_t v) {
+    wire_put_u32(buf, (uint32_t) v);
+    wire_put_u32(buf + 4, (uint32_t) (v >> 32));
+}
+
+uint64_t wire_get_u64(const uint8_t *buf) {
+    return wire_get_u32(buf) | (uint64_t) wire_get_u32(buf + 4) << 32;
+}
+
+uint64_t wire_zigzag(int64_t v) {
+    return ((uint64_t) v << 1) ^ (uint64_t) (v >> 63);
+}
+
+int64_t wire_unzigzag(uint64_t v) {
+    return (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+}
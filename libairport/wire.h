@@ -0,0 +1,100 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file wire.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible methods of the binary encoding.
+ *
+ * Numbers are encoded as variable-length integers: seven bits per byte, least significant group first, the high bit
+ * set on all bytes but the last. Small numbers, like counts and time differences, take a single byte. Fixed-size
+ * fields are little-endian.
+ *
+ */
+
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Maximum number of bytes of an encoded variable-length integer
+ *
+ * */
+#define WIRE_VARINT_MAX 10
+
+/**
+ * @brief Encodes a variable-length integer
+ * @param uint8_t* Buffer with room for at least WIRE_VARINT_MAX bytes
+ * @param uint64_t The number
+ * @return Number of bytes written
+ *
+ * */
+size_t wire_put_varint(uint8_t *, uint64_t);
+
+/**
+ * @brief Decodes a variable-length integer
+ * @param uint8_t** Position in the buffer, is advanced past the number
+ * @param uint8_t* End of the buffer
+ * @param uint64_t* Receives the number
+ * @return True, if a complete number was read, false if the buffer ends before or the number is too long
+ *
+ * */
+bool wire_get_varint(const uint8_t **, const uint8_t *, uint64_t *);
+
+/**
+ * @brief Encodes a 32 bit number in little-endian byte order
+ * @param uint8_t* Buffer with room for 4 bytes
+ * @param uint32_t The number
+ *
+ * */
+void wire_put_u32(uint8_t *, uint32_t);
+
+/**
+ * @brief Decodes a 32 bit number in little-endian byte order
+ * @param uint8_t* Buffer with 4 bytes
+ * @return The number
+ *
+ * */
+uint32_t wire_get_u32(const uint8_t *);
+
+/**
+ * @brief Encodes a 64 bit number in little-endian byte order
+ * @param uint8_t* Buffer with room for 8 bytes
+ * @param uint64_t The number
+ *
+ * */
+void wire_put_u64(uint8_t *, uint64_t);
+
+/**
+ * @brief Decodes a 64 bit number in little-endian byte order
+ * @param uint8_t* Buffer with 8 bytes
+ * @return The number
+ *
+ * */
+uint64_t wire_get_u64(const uint8_t *);
+
+/**
+ * @brief Maps a signed number to an unsigned one, so that numbers close to zero stay small
+ * @param int64_t The number
+ * @return 0, -1, 1, -2, 2, ... are mapped to 0, 1, 2, 3, 4, ...
+ *
+ * */
+uint64_t wire_zigzag(int64_t);
+
+/**
+ * @brief Reverses wire_zigzag()
+ * @param uint64_t The mapped number
+ * @return The signed number
+ *
+ * */
+int64_t wire_unzigzag(uint64_t);
+
+#endif /* WIRE_H */
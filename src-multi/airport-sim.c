@@ -15,30 +15,46 @@
 *
 */
 
+#include <errno.h>
+#include <poll.h>
 #include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <unistd.h>
 #include "airport.h"
+#include "arrival.h"
+#include "bayindex.h"
+#include "cancel.h"
+#include "checkpoint.h"
+#include "cluster.h"
+#include "config.h"
+#include "flights.h"
+#include "lockstat.h"
+#include "logger.h"
+#include "network.h"
+#include "scheduler.h"
+#include "sim.h"
+#include "stats.h"
+#include "strbuf.h"
+#include "timesource.h"
 #include "tools.h"
+#include "trace.h"
 
 
-#define NUM_LANDING_THREADS 15
-#define NUM_TAKEOFF_THREADS 5
-
 /**
-* @brief This is set to exit when the application should exit gracefully.
+* @brief Representation of the airport for the simulation.
 *
 * */
-bool airport_exit = false;
+airport *ap;
 
 /**
-* @brief Representation of the airport for the simulation.
+* @brief Arrival processes of the landing and the take-off actors.
 *
 * */
-airport *ap;
+arrival landing_process, takeoff_process;
 
 /**
 * @brief Prints the help for airport-sim to the console.
@@ -46,7 +62,47 @@ airport *ap;
 *
 * */
 void usage(char *pname) {
-    fprintf(stderr, "usage: %s <landing probability> <takeoff probability>\n", pname);
+    fprintf(stderr, "usage: %s [-c file] [-m realtime|tasks|virtual|network] [-b bays] [-r runways] [-L landing] [-T takeoff] [-w workers] [-A airports] [-S shards] [-p processes] [-N node -H peers] [-F minutes] [-t file] [-R file] [-k file] [-K file] [-d seconds] [-B] [-n events] [-P] [-a process] [-C clock] [-X speed] [-s seed] [-l level] [-v] <landing probability> <takeoff probability>\n", pname);
+    fprintf(stderr, "  -c  read settings from a file with one \"name = value\" per line, later options override them\n");
+    fprintf(stderr, "      names: mode, bays, runways, landing_actors, takeoff_actors, workers, airports, shards, processes,\n");
+    fprintf(stderr, "             node, peers, flight_time, trace, replay, checkpoint, restore, duration, clock, speed, seed, log,\n");
+    fprintf(stderr, "             benchmark, events, lockstat, landing_probability, takeoff_probability, arrivals,\n");
+    fprintf(stderr, "             landing_arrivals, takeoff_arrivals\n");
+    fprintf(stderr, "  -m  simulation mode: realtime threads (default), realtime tasks on a worker pool, discrete-event virtual time,\n");
+    fprintf(stderr, "      or a network of airports in virtual time\n");
+    fprintf(stderr, "  -b  number of parking bays (default %d)\n", AIRPORT_DEFAULT_BAYS);
+    fprintf(stderr, "  -r  number of runways (default %d)\n", AIRPORT_DEFAULT_RUNWAYS);
+    fprintf(stderr, "  -L  number of landing threads or actors (default 15)\n");
+    fprintf(stderr, "  -T  number of take-off threads or actors (default 5)\n");
+    fprintf(stderr, "  -w  number of worker threads in tasks mode (default: one per processor)\n");
+    fprintf(stderr, "  -A  number of airports in network mode, airport 0 is the hub (default 8)\n");
+    fprintf(stderr, "  -S  number of threads in network mode (default: one per processor)\n");
+    fprintf(stderr, "  -p  number of local processes in network mode, connected by Unix domain sockets (default 1)\n");
+    fprintf(stderr, "  -N  index of this process in the list of peers (default 0)\n");
+    fprintf(stderr, "  -H  run the network in processes connected over TCP, given as a comma separated list of host:port\n");
+    fprintf(stderr, "  -F  shortest flight time between airports in minutes (default 30)\n");
+    fprintf(stderr, "  -t  write every change of the bays and runways to a binary trace file, not in network mode\n");
+    fprintf(stderr, "  -R  replay a trace file against the airport and print the resulting state, as fast as possible\n");
+    fprintf(stderr, "  -k  save the bays, parked planes, runways and random state to a checkpoint file at the end, in the\n");
+    fprintf(stderr, "      realtime modes the random state of every landing and take-off actor\n");
+    fprintf(stderr, "  -K  start from a checkpoint file instead of an empty airport, with its bays, runways and seed\n");
+    fprintf(stderr, "      (neither in network nor in replay mode)\n");
+    fprintf(stderr, "  -d  simulated seconds in virtual and network mode, seconds to run in benchmark mode (default 86400)\n");
+    fprintf(stderr, "  -B  benchmark: run without user interaction and print a report of \"name=value\" lines\n");
+    fprintf(stderr, "  -n  in benchmark mode, stop after this many landings and take-offs (default: no limit)\n");
+    fprintf(stderr, "  -P  profile lock contention, shown with the state of the airport and in the benchmark report\n");
+    fprintf(stderr, "  -a  arrival process of all actors: tick (default, every %d ms with the probability), poisson (exponential\n",
+            ARRIVAL_TICK_MS);
+    fprintf(stderr, "      times, same mean rate), poisson:R (R operations per simulated hour of all actors of a kind) or\n");
+    fprintf(stderr, "      empirical:FILE (times between operations in seconds drawn from FILE, one per line, optional weight)\n");
+    fprintf(stderr, "  -C  clock of all timestamps: monotonic (default), coarse (cheaper, tick precision) or tsc (calibrated\n");
+    fprintf(stderr, "      time stamp counter, falls back to monotonic where it is not stable)\n");
+    fprintf(stderr, "  -X  run the realtime modes this many times faster: runway times, ticks and timeouts get shorter, the\n");
+    fprintf(stderr, "      threads stay real, -d and all reported times are in simulated time (default 1, at most %d)\n",
+            TIMESOURCE_MAX_SPEED);
+    fprintf(stderr, "  -s  master seed of the random number generators (default: current time)\n");
+    fprintf(stderr, "  -l  log level: off, error, warn, info or debug (default: info in realtime mode, off in virtual mode)\n");
+    fprintf(stderr, "  -v  same as -l info\n");
 }
 
 /**
@@ -58,61 +114,625 @@ void print_banner() {
     printf("%s", "Press p or P followed by return to display the state of the airport.\n");
     printf("%s", "Press q or Q followed by return to terminate the simulation.\n\n");
     printf("%s", "Press return to start the simulation.\n");
-    getchar();
+    fflush(stdout);
+    /* read byte by byte, as stdio would buffer the input meant for the monitor thread */
+    char c;
+    ssize_t n;
+    do {
+        n = read(STDIN_FILENO, &c, 1);
+    } while ((n == 1 && c != '\n') || (n < 0 && errno == EINTR));
+}
+
+/**
+* @brief Prints the lock contention to the console, if locks are profiled
+*
+* */
+void print_lockstat() {
+    if (!lockstat_enabled())
+        return;
+    char *c = lockstat_to_string(false);
+    printf("%s", c);
+    free(c);
 }
 
 /**
 * @brief Monitor thread
 *
 * The monitor thread interacts with the user while the airport-simulation is running.
-* To print the state of the airport, the user can press 'p' or 'P'.
-* To exit the application, the user can press 'q' or 'Q'.
+* To print the state of the airport and the latency percentiles, the user can press 'p' or 'P'.
+* To exit the application, the user can press 'q' or 'Q', which requests cancellation.
+*
+* The monitor waits for input and for the cancellation token together, so it also ends at once, when the simulation
+* is stopped otherwise.
 *
 * */
 void monitor_thread_func() {
-    while (!airport_exit) {
-        char c = getchar();
-        if (c == 'p' || c == 'P') {
-            char *c = airport_to_string(ap);
-            printf("%s", c);
-            free(c);
+    struct pollfd fds[2] = {{.fd = STDIN_FILENO, .events = POLLIN}, {.fd = cancel_get_fd(), .events = POLLIN}};
+    while (!cancel_requested()) {
+        if (poll(fds, 2, -1) < 0 || fds[0].revents == 0)
+            continue;
+        char buf[64];
+        ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+        if (n <= 0) {
+            /* end of input, only cancellation can stop the monitor now */
+            fds[0].fd = -1;
+            continue;
         }
-        if (c == 'q' || c == 'Q') {
-            airport_exit = true;
+        for (ssize_t i = 0; i < n; ++i) {
+            if (buf[i] == 'p' || buf[i] == 'P') {
+                airport_print(ap, stdout);
+                char *c = stats_to_string();
+                printf("%s", c);
+                free(c);
+                print_lockstat();
+            }
+            if (buf[i] == 'q' || buf[i] == 'Q') {
+                cancel_request();
+            }
         }
     }
 }
 
+/**
+* @brief Arguments of a landing or take-off thread
+*
+* */
+typedef struct worker_args {
+    const arrival *process; /**< Arrival process deciding when to land or take off. */
+    unsigned int stream; /**< Stream number of the thread's random number generator. */
+    bool restored; /**< The generator continues from rng instead of starting the stream. */
+    uint64_t *rng; /**< State of the generator, four words, written when the thread ends. */
+} worker_args;
+
 /**
 * @brief Landing thread
-* @param int Landing probability
+* @param worker_args* Arrival process and random stream
 *
-* The landing thread lands a plane on the airport with the given probability.
+* The landing thread sleeps until its arrival process wakes it up and lands a plane on the airport, if the process
+* says so.
 * */
-void landing_thread_func(int prob) {
-    while (!airport_exit) {
-        if (prob_bool(prob)) {
+void landing_thread_func(worker_args *args) {
+    if (args->restored)
+        rng_set_state(args->rng);
+    else
+        rng_thread_init(args->stream);
+    long long next = current_timestamp() + arrival_first(args->process);
+    while (cancel_sleep_until(next)) {
+        if (arrival_fires(args->process)) {
             airport_land_plane(ap);
         }
-        msleep(500);
+        next = arrival_next_at(args->process, next, current_timestamp());
     }
+    rng_get_state(args->rng);
 }
 
 /**
 * @brief Takeoff thread
-* @param int Take-off probability
+* @param worker_args* Arrival process and random stream
 *
-* The take-off thread takes off a plane of the airport with the given probability.
+* The take-off thread sleeps until its arrival process wakes it up and takes off a plane of the airport, if the process
+* says so.
 * */
-void takeoff_thread_func(int prob) {
-    while (!airport_exit) {
-        if (prob_bool(prob)) {
+void takeoff_thread_func(worker_args *args) {
+    if (args->restored)
+        rng_set_state(args->rng);
+    else
+        rng_thread_init(args->stream);
+    long long next = current_timestamp() + arrival_first(args->process);
+    while (cancel_sleep_until(next)) {
+        if (arrival_fires(args->process)) {
             airport_takeoff_plane(ap);
         }
-        msleep(500);
+        next = arrival_next_at(args->process, next, current_timestamp());
+    }
+    rng_get_state(args->rng);
+}
+
+/**
+* @brief Percentiles of the recorded times in the benchmark report
+*
+* */
+static const struct {
+    const char *name; /**< Suffix of the reported value. */
+    double percentile; /**< The percentile. */
+} percentiles[] = {
+        {"p50", 50},
+        {"p90", 90},
+        {"p99", 99},
+        {"p999", 99.9},
+        {"p9999", 99.99},
+        {"max", 100},
+};
+
+/**
+* @brief Checks if the benchmark has reached its end
+* @param config* Settings of the benchmark
+* @param time_t Milliseconds the benchmark is running
+* @return True, if the duration has passed or the number of events has been reached
+*
+* */
+static bool benchmark_done(config *cfg, time_t elapsed) {
+    if (elapsed >= cfg->seconds * 1000LL)
+        return true;
+    return cfg->events > 0 && stats_get_count(STATS_LANDINGS) + stats_get_count(STATS_TAKEOFFS) >= cfg->events;
+}
+
+/**
+* @brief Computes the share of time the runways of an airport were busy
+* @param airport* The airport
+* @param double Seconds the simulation ran
+* @return Busy time of all runways divided by the time they were available
+*
+* */
+static double runway_utilization(airport *a, double seconds) {
+    time_t busy = 0;
+    for (int i = 0; i < airport_get_num_runways(a); ++i) {
+        unsigned long operations;
+        time_t busy_time;
+        airport_get_runway_stats(a, i, &operations, &busy_time);
+        busy += busy_time;
+    }
+    return seconds > 0 ? busy / (seconds * 1000.0 * airport_get_num_runways(a)) : 0;
+}
+
+/**
+* @brief Creates the machine-readable report of a benchmark
+* @param config* Settings of the benchmark
+* @param double Seconds the simulation ran, virtual in virtual mode
+* @param double Wall clock seconds the simulation ran
+* @param double Runway utilization, see runway_utilization()
+* @return A pointer to the report, one "name=value" per line. Has to be freed by caller.
+*
+* Counters and times are taken from the statistics.
+* */
+static char *benchmark_to_string(config *cfg, double seconds, double wall, double utilization) {
+    static const char *modes[] = {"realtime", "tasks", "virtual", "network", "replay"};
+    strbuf *sb = strbuf_init();
+
+    unsigned long landings = stats_get_count(STATS_LANDINGS);
+    unsigned long takeoffs = stats_get_count(STATS_TAKEOFFS);
+
+    strbuf_printf(sb, "mode=%s\nclock=%s\nspeed=%d\nseed=%llu\nbays=%d\nrunways=%d\nlanding_actors=%d\n"
+                      "takeoff_actors=%d\n", modes[cfg->mode], timesource_get_name(timesource_get()),
+                  timesource_get_speed(), (unsigned long long) cfg->seed, cfg->num_bays, cfg->num_runways,
+                  cfg->num_landing, cfg->num_takeoff);
+    if (cfg->mode != CONFIG_REPLAY)
+        strbuf_printf(sb, "landing_arrivals=%s\ntakeoff_arrivals=%s\n", cfg->landing_arrivals, cfg->takeoff_arrivals);
+    if (cfg->mode == CONFIG_NETWORK)
+        strbuf_printf(sb, "airports=%d\nshards=%d\nflight_minutes=%d\n", cfg->num_airports, cfg->num_shards,
+                      cfg->flight_minutes);
+    strbuf_printf(sb, "seconds=%.3f\nwall_seconds=%.3f\n", seconds, wall);
+    strbuf_printf(sb, "landings=%lu\ntakeoffs=%lu\ntimeouts=%lu\n", landings, takeoffs,
+                  stats_get_count(STATS_TIMEOUTS));
+    strbuf_printf(sb, "landings_per_sec=%.3f\ntakeoffs_per_sec=%.3f\nrunway_utilization=%.4f\n",
+                  seconds > 0 ? landings / seconds : 0, seconds > 0 ? takeoffs / seconds : 0, utilization);
+    for (int t = 0; t < STATS_NUM_TIMES; ++t) {
+        histogram *h = stats_get_histogram(t);
+        strbuf_printf(sb, "%s_samples=%lu\n", stats_get_name(t), histogram_count(h));
+        for (size_t i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); ++i)
+            strbuf_printf(sb, "%s_%s_ms=%ld\n", stats_get_name(t), percentiles[i].name,
+                          histogram_percentile(h, percentiles[i].percentile));
+        histogram_destroy(h);
+    }
+    if (lockstat_enabled()) {
+        char *locks = lockstat_to_string(true);
+        strbuf_printf(sb, "%s", locks);
+        free(locks);
+    }
+    return strbuf_release(sb);
+}
+
+/**
+* @brief Starts recording a trace of the airport, if one is configured
+* @param config* Settings of the run
+*
+* */
+static void start_trace(config *cfg) {
+    if (cfg->trace[0] != '\0' && !trace_start(cfg->trace, cfg->num_bays, cfg->num_runways, cfg->seed))
+        fprintf(stderr, "%s: cannot create trace\n", cfg->trace);
+}
+
+/**
+* @brief Writes the rest of the trace of the airport, if one is recorded
+* @param config* Settings of the run
+*
+* No thread may use the airport any more.
+* */
+static void stop_trace(config *cfg) {
+    if (trace_enabled() && !trace_stop())
+        fprintf(stderr, "%s: cannot write trace\n", cfg->trace);
+}
+
+/**
+* @brief Restores the airport from a checkpoint
+* @param checkpoint* The checkpoint, or NULL to start with an empty airport, is freed
+* @param time_t Current time
+* @param uint64_t* Receives the states of the actors' generators, four words each, or NULL in virtual time
+* @param int Number of actors
+* @return Number of actors, whose generator was restored, the first ones
+*
+* */
+static int restore_checkpoint(checkpoint *ck, time_t now, uint64_t *streams, int num_actors) {
+    if (ck == NULL)
+        return 0;
+    if (!checkpoint_restore(ck, ap, now))
+        fprintf(stderr, "checkpoint does not fit the airport, some planes were not restored\n");
+    int n = checkpoint_get_num_streams(ck) < num_actors ? checkpoint_get_num_streams(ck) : num_actors;
+    for (int i = 0; i < n; ++i)
+        checkpoint_get_stream(ck, i, streams + 4 * i);
+    checkpoint_destroy(ck);
+    return n;
+}
+
+/**
+* @brief Saves the airport to a checkpoint, if one is configured
+* @param config* Settings of the run
+* @param time_t Current time
+* @param uint64_t* States of the actors' generators, four words each, or NULL in virtual time
+* @param int Number of actors
+*
+* No thread may use the airport any more.
+* */
+static void save_checkpoint(config *cfg, time_t now, const uint64_t *streams, int num_actors) {
+    if (cfg->checkpoint[0] != '\0' && !checkpoint_save(cfg->checkpoint, ap, now, cfg->seed, streams, num_actors))
+        fprintf(stderr, "%s: cannot write checkpoint\n", cfg->checkpoint);
+}
+
+/**
+* @brief Runs the discrete-event simulation in virtual time
+* @param config* Settings of the simulation
+* @param checkpoint* Checkpoint to continue from, or NULL to start with an empty airport, is freed
+*
+* The simulation runs without user interaction and prints statistics and the state of the airport when it is done,
+* or the benchmark report in benchmark mode. From a checkpoint, the virtual time goes on from the time it was taken at.
+* */
+void run_virtual(config *cfg, checkpoint *ck) {
+    struct timespec start, end;
+    ap = airport_init("lumans airport", cfg->num_bays, cfg->num_runways);
+    sim *s = sim_init(ap, &landing_process, &takeoff_process, cfg->num_landing, cfg->num_takeoff);
+    if (ck != NULL)
+        sim_set_time(s, checkpoint_get_time(ck));
+    restore_checkpoint(ck, sim_now(s), NULL, 0);
+    time_t begin = sim_now(s);
+    /* nothing is lost in virtual mode, the simulation waits for the logger instead */
+    logger_init(cfg->loglevel < 0 ? LOGGER_OFF : cfg->loglevel, stdout, true);
+    start_trace(cfg);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (cfg->benchmark && cfg->events > 0) {
+        /* check the number of events after every simulated second */
+        while (!benchmark_done(cfg, sim_now(s) - begin)) {
+            time_t left = cfg->seconds * 1000LL - (sim_now(s) - begin);
+            sim_run(s, left < 1000 ? left : 1000);
+        }
+    } else {
+        sim_run(s, cfg->seconds * 1000LL);
     }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    logger_destroy();
+    stop_trace(cfg);
+    save_checkpoint(cfg, sim_now(s), NULL, 0);
+    double wall = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    char *c;
+    if (cfg->benchmark) {
+        /* the runways' usage includes the time before the checkpoint */
+        c = benchmark_to_string(cfg, (sim_now(s) - begin) / 1000.0, wall,
+                                runway_utilization(ap, sim_now(s) / 1000.0));
+        printf("%s", c);
+        free(c);
+    } else {
+        airport_print(ap, stdout);
+        c = sim_to_string(s);
+        printf("%s", c);
+        free(c);
+        c = stats_to_string();
+        printf("%s", c);
+        free(c);
+        print_lockstat();
+        printf("Seed: %llu\n", (unsigned long long) cfg->seed);
+        printf("Wall clock time: %.3f seconds\n", wall);
+    }
+
+    sim_destroy(s);
+    airport_destroy(ap);
+    stats_destroy();
 }
 
+/**
+* @brief Runs a network of airports in virtual time
+* @param config* Settings of the simulation
+*
+* Like run_virtual(), but the airports are spread over several threads, and maybe processes. The benchmark report
+* contains the sums of the airports of a process and their average runway utilization. The number of events is not
+* checked, the network always runs for the whole duration.
+*
+* In a cluster, process 0 prints the statistics of all airports, followed by the latencies or benchmark report of each
+* process, which the others send it.
+* */
+void run_network(config *cfg) {
+    struct timespec start, end;
+    cluster *cl = NULL;
+    if (cfg->peers[0] != '\0') {
+        cl = cluster_connect(cfg->node, cfg->peers);
+        if (cl == NULL) {
+            fprintf(stderr, "cannot connect to the peers %s as node %d\n", cfg->peers, cfg->node);
+            return;
+        }
+    } else if (cfg->processes > 1) {
+        cl = cluster_fork(cfg->processes < cfg->num_airports ? cfg->processes : cfg->num_airports);
+    }
+    network *n = network_init(cfg, cl, &landing_process, &takeoff_process);
+    logger_init(cfg->loglevel < 0 ? LOGGER_OFF : cfg->loglevel, stdout, true);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    network_run(n, cfg->seconds * 1000LL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    logger_destroy();
+    double wall = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    char *c;
+    strbuf *sb = strbuf_init();
+    if (cfg->benchmark) {
+        double utilization = 0;
+        int num_local = 0;
+        cfg->num_shards = network_get_num_shards(n);
+        for (int i = 0; i < network_get_num_airports(n); ++i) {
+            airport *a = network_get_airport(n, i);
+            if (a != NULL) {
+                utilization += runway_utilization(a, cfg->seconds);
+                num_local++;
+            }
+        }
+        c = benchmark_to_string(cfg, cfg->seconds, wall, num_local > 0 ? utilization / num_local : 0);
+        strbuf_printf(sb, "%s", c);
+        free(c);
+    } else {
+        c = network_to_string(n);
+        if (c != NULL)
+            printf("%s", c);
+        free(c);
+        c = stats_to_string();
+        strbuf_printf(sb, "%s", c);
+        free(c);
+        if (lockstat_enabled()) {
+            c = lockstat_to_string(false);
+            strbuf_printf(sb, "%s", c);
+            free(c);
+        }
+        strbuf_printf(sb, "Wall clock time: %.3f seconds\n", wall);
+    }
+    c = strbuf_release(sb);
+
+    if (cl == NULL) {
+        printf("%s", c);
+        if (!cfg->benchmark)
+            printf("Seed: %llu\n", (unsigned long long) cfg->seed);
+    } else if (cluster_get_index(cl) != 0) {
+        cluster_send(cl, 0, (const uint8_t *) c, strlen(c));
+    } else {
+        for (int i = 0; i < cluster_get_size(cl); ++i) {
+            size_t len = strlen(c);
+            uint8_t *text = (uint8_t *) c;
+            if (i > 0)
+                text = cluster_recv(cl, i, &len);
+            printf(cfg->benchmark ? "process=%d\n" : "Process %d:\n", i);
+            fwrite(text, 1, len, stdout);
+            if (i > 0)
+                free(text);
+        }
+        if (!cfg->benchmark)
+            printf("Seed: %llu\n", (unsigned long long) cfg->seed);
+    }
+    free(c);
+
+    network_destroy(n);
+    if (cl != NULL)
+        cluster_destroy(cl);
+    stats_destroy();
+}
+
+/**
+* @brief Virtual time of the replayed event
+*
+* */
+static time_t replay_now;
+
+/**
+* @brief Source of current_timestamp() while replaying
+* @return Timestamp of the replayed event
+*
+* */
+static time_t replay_timestamp() {
+    return replay_now;
+}
+
+/**
+* @brief Applies an event of a trace to the airport
+* @param trace_record* The event
+* @param char* State of every bay of the airport, as in bayindex.h, is updated
+* @param bool* For every runway, true if it is in use, is updated
+* @return True, if the event was applied, false if it does not fit the state of the airport
+*
+* */
+static bool replay_event(trace_record *rec, char *bays, bool *runways) {
+    bool bay_ok = rec->id >= 0 && rec->id < airport_get_num_bays(ap);
+    bool runway_ok = rec->id >= 0 && rec->id < airport_get_num_runways(ap);
+    plane *p;
+    switch (rec->type) {
+        case TRACE_RESERVE:
+            if (!airport_reserve_bay_nr(ap, rec->id))
+                return false;
+            bays[rec->id] = BAY_RESERVED;
+            return true;
+        case TRACE_PARK:
+            if (!bay_ok || bays[rec->id] != BAY_RESERVED || rec->runway < 0 ||
+                rec->runway >= airport_get_num_runways(ap))
+                return false;
+            airport_park_plane(ap, rec->id, plane_init_named(rec->name), rec->runway);
+            bays[rec->id] = BAY_OCCUPIED;
+            stats_count(STATS_LANDINGS);
+            return true;
+        case TRACE_UNPARK:
+            if ((p = airport_unpark_plane_nr(ap, rec->id)) == NULL)
+                return false;
+            plane_destroy(p);
+            bays[rec->id] = BAY_RESERVED;
+            stats_count(STATS_TAKEOFFS);
+            return true;
+        case TRACE_RELEASE:
+            if (!bay_ok || bays[rec->id] != BAY_RESERVED)
+                return false;
+            airport_release_bay(ap, rec->id);
+            bays[rec->id] = BAY_FREE;
+            return true;
+        case TRACE_ACQUIRE:
+            if (!airport_acquire_runway_nr(ap, rec->id))
+                return false;
+            runways[rec->id] = true;
+            return true;
+        case TRACE_FREE:
+            if (!runway_ok || !runways[rec->id])
+                return false;
+            airport_release_runway(ap, rec->id);
+            runways[rec->id] = false;
+            return true;
+    }
+    return false;
+}
+
+/**
+* @brief Replays a trace file against the airport
+* @param config* Settings of the replay
+* @return True, if the trace could be read
+*
+* The events are applied in their order, as fast as possible, with the clock set to the time of each event. So the
+* airport, its runway usage and the turnaround times end up as in the traced run, whatever its mode was. Events,
+* which do not fit the state of the airport, are skipped and counted. With a trace file set, the replay is traced
+* again, which gives the same file, if the airport code did not change.
+* */
+bool run_replay(config *cfg) {
+    trace_reader *r = trace_reader_init(cfg->replay);
+    if (r == NULL) {
+        fprintf(stderr, "%s: cannot read trace\n", cfg->replay);
+        return false;
+    }
+    cfg->num_bays = trace_reader_get_num_bays(r);
+    cfg->num_runways = trace_reader_get_num_runways(r);
+    cfg->seed = trace_reader_get_seed(r);
+    ap = airport_init("lumans airport", cfg->num_bays, cfg->num_runways);
+    char *bays = (char *) malloc(cfg->num_bays);
+    memset(bays, BAY_FREE, cfg->num_bays);
+    bool *runways = (bool *) calloc(cfg->num_runways, sizeof(bool));
+    set_timestamp_source(replay_timestamp);
+    start_trace(cfg);
+
+    struct timespec start, end;
+    unsigned long events = 0, rejected = 0;
+    time_t first = 0;
+    trace_record rec;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (trace_reader_next(r, &rec)) {
+        if (events++ == 0)
+            first = rec.time;
+        replay_now = rec.time;
+        if (!replay_event(&rec, bays, runways))
+            rejected++;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    stop_trace(cfg);
+    double wall = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    double seconds = (replay_now - first) / 1000.0;
+    if (events < trace_reader_get_count(r))
+        fprintf(stderr, "%s: trace is damaged after %lu events\n", cfg->replay, events);
+
+    char *c;
+    if (cfg->benchmark) {
+        c = benchmark_to_string(cfg, seconds, wall, runway_utilization(ap, seconds));
+        printf("%sreplay_events=%lu\nreplay_rejected=%lu\nreplay_events_per_sec=%.0f\n", c, events, rejected,
+               wall > 0 ? events / wall : 0);
+        free(c);
+    } else {
+        airport_print(ap, stdout);
+        c = stats_to_string();
+        printf("%s", c);
+        free(c);
+        printf("Replayed %lu of %lu events, %.2f hours, in %.3f seconds, %lu did not fit the airport\n", events,
+               trace_reader_get_count(r), seconds / 3600, wall, rejected);
+    }
+
+    set_timestamp_source(NULL);
+    free(runways);
+    free(bays);
+    trace_reader_destroy(r);
+    airport_destroy(ap);
+    stats_destroy();
+    return true;
+}
+
+/**
+* @brief Lets a realtime benchmark run until it is done and stops it
+* @param config* Settings of the benchmark
+* @return Wall clock seconds the benchmark ran, the simulated time is longer by the speed factor
+*
+* Takes the place of the monitor thread, requests cancellation when the benchmark is done.
+* */
+static double run_benchmark(config *cfg) {
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    time_t elapsed = 0;
+    while (!benchmark_done(cfg, elapsed * timesource_get_speed())) {
+        msleep(10);
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        elapsed = (now.tv_sec - start.tv_sec) * 1000LL + (now.tv_nsec - start.tv_nsec) / 1000000;
+    }
+    cancel_request();
+    return elapsed / 1000.0;
+}
+
+/**
+* @brief Frees the arrival processes of the actors
+*
+* No actor may use them any more.
+* */
+static void destroy_arrivals() {
+    arrival_destroy(&landing_process);
+    arrival_destroy(&takeoff_process);
+}
+
+/**
+* @brief Option letters and the names of the settings they set
+*
+* */
+static const struct {
+    int opt; /**< Command line option. */
+    const char *name; /**< Name of the setting. */
+} options[] = {
+        {'m', "mode"},
+        {'b', "bays"},
+        {'r', "runways"},
+        {'L', "landing_actors"},
+        {'T', "takeoff_actors"},
+        {'w', "workers"},
+        {'A', "airports"},
+        {'S', "shards"},
+        {'p', "processes"},
+        {'N', "node"},
+        {'H', "peers"},
+        {'F', "flight_time"},
+        {'t', "trace"},
+        {'R', "replay"},
+        {'k', "checkpoint"},
+        {'K', "restore"},
+        {'d', "duration"},
+        {'n', "events"},
+        {'a', "arrivals"},
+        {'C', "clock"},
+        {'X', "speed"},
+        {'s', "seed"},
+        {'l', "log"},
+};
+
 /**
 * @brief Main entry point of airport-sim
 * @param int Number of arguments
@@ -121,75 +741,228 @@ void takeoff_thread_func(int prob) {
 *
 * */
 int main(int argc, char **argv) {
-    /* initialize random seed */
-    srand(time(NULL));
+    config cfg;
+    config_defaults(&cfg);
 
-    /* set default value for probabilities */
-    int landprob = 50;
-    int takeoffprob = 50;
-    /* program started with one argument */
-    if (argc > 1) {
-        /* user wants to see help */
-        if (!strcmp(argv[1], "-h")) {
-            usage(argv[0]);
-            return 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "hc:m:b:r:L:T:w:A:S:p:N:H:F:t:R:k:K:d:Bn:Pa:C:X:s:l:v")) != -1) {
+        switch (opt) {
+            case 'c':
+                if (!config_load(&cfg, optarg)) {
+                    usage(argv[0]);
+                    return -1;
+                }
+                break;
+            case 'v':
+                cfg.loglevel = LOGGER_INFO;
+                break;
+            case 'B':
+                cfg.benchmark = true;
+                break;
+            case 'P':
+                cfg.lockstat = true;
+                break;
+            case 'h':
+                /* user wants to see help */
+                usage(argv[0]);
+                return 0;
+            default: {
+                const char *name = NULL;
+                for (size_t i = 0; i < sizeof(options) / sizeof(options[0]); ++i) {
+                    if (options[i].opt == opt)
+                        name = options[i].name;
+                }
+                if (name == NULL || !config_set(&cfg, name, optarg)) {
+                    usage(argv[0]);
+                    return -1;
+                }
+            }
         }
-        landprob = atoi(argv[1]);
     }
 
-    /* program started with two argument */
-    if (argc > 2) {
-        takeoffprob = atoi(argv[2]);
+    /* program started with one argument */
+    if (argc > optind && !config_set(&cfg, "landing_probability", argv[optind])) {
+        usage(argv[0]);
+        return -1;
     }
 
-    /* arguments are out of allowed range */
-    if (landprob < 1 || landprob > 90 || takeoffprob < 1 || takeoffprob > 90) {
+    /* program started with two argument */
+    if (argc > optind + 1 && !config_set(&cfg, "takeoff_probability", argv[optind + 1])) {
         usage(argv[0]);
         return -1;
     }
 
-    print_banner();
+    /* a checkpoint brings its airport size and seed */
+    checkpoint *ck = NULL;
+    if (cfg.restore[0] != '\0' && cfg.mode != CONFIG_NETWORK && cfg.mode != CONFIG_REPLAY) {
+        ck = checkpoint_init(cfg.restore);
+        if (ck == NULL) {
+            fprintf(stderr, "%s: cannot read checkpoint\n", cfg.restore);
+            return -1;
+        }
+        cfg.num_bays = checkpoint_get_num_bays(ck);
+        cfg.num_runways = checkpoint_get_num_runways(ck);
+        cfg.seed = checkpoint_get_seed(ck);
+    }
+
+    /* initialize random seed and the clock, before any thread is started */
+    rng_seed(cfg.seed);
+    if (timesource_select(cfg.clock) != cfg.clock)
+        fprintf(stderr, "%s clock is not available, using %s\n", timesource_get_name(cfg.clock),
+                timesource_get_name(timesource_get()));
+    timesource_set_speed(cfg.speed);
+    lockstat_enable(cfg.lockstat);
+
+    if (cfg.mode == CONFIG_REPLAY)
+        return run_replay(&cfg) ? 0 : -1;
+
+    /* every actor of a kind shares its process, which reads the file of an empirical one once */
+    if (!arrival_init(&landing_process, cfg.landing_arrivals, cfg.landprob, cfg.num_landing) ||
+        !arrival_init(&takeoff_process, cfg.takeoff_arrivals, cfg.takeoffprob, cfg.num_takeoff)) {
+        destroy_arrivals();
+        if (ck != NULL)
+            checkpoint_destroy(ck);
+        return -1;
+    }
+
+    if (cfg.mode == CONFIG_VIRTUAL) {
+        run_virtual(&cfg, ck);
+        destroy_arrivals();
+        return 0;
+    }
+    if (cfg.mode == CONFIG_NETWORK) {
+        run_network(&cfg);
+        destroy_arrivals();
+        return 0;
+    }
+
+    /* a benchmark needs nobody to press return and does not log by default */
+    int loglevel = cfg.loglevel < 0 ? (cfg.benchmark ? LOGGER_OFF : LOGGER_INFO) : cfg.loglevel;
+    if (!cfg.benchmark)
+        print_banner();
 
     /* initialize the airport */
-    ap = airport_init("lumans airport");
+    ap = airport_init("lumans airport", cfg.num_bays, cfg.num_runways);
+    /* every actor draws from its own stream, which the checkpoint carries on */
+    int num_actors = cfg.num_landing + cfg.num_takeoff;
+    uint64_t *streams = calloc(4 * (num_actors > 0 ? num_actors : 1), sizeof(uint64_t));
+    int num_restored = restore_checkpoint(ck, current_timestamp(), streams, num_actors);
+    logger_init(loglevel, stdout, false);
+    start_trace(&cfg);
 
-    pthread_t landing_thread[NUM_LANDING_THREADS];
-    pthread_t takeoff_thread[NUM_TAKEOFF_THREADS];
     pthread_t monitor_thread;
 
     /* set of attributes for the thread */
     pthread_attr_t attr;
     pthread_attr_init(&attr);
 
-    /* create three threads */
-    pthread_create(&monitor_thread, &attr, (void *(*)(void *)) monitor_thread_func, NULL);
+    /* create the monitor thread */
+    if (!cfg.benchmark)
+        pthread_create(&monitor_thread, &attr, (void *(*)(void *)) monitor_thread_func, NULL);
+
+    char *c;
+    if (cfg.mode == CONFIG_TASKS) {
+        /* landings and take-offs run as tasks on a fixed pool of workers */
+        scheduler *s = scheduler_init(cfg.workers);
+        flights *f = flights_init(s, ap, &landing_process, &takeoff_process, cfg.num_landing, cfg.num_takeoff,
+                                  streams, num_restored);
+        if (cfg.benchmark) {
+            double wall = run_benchmark(&cfg);
+            double seconds = wall * cfg.speed;
+            c = benchmark_to_string(&cfg, seconds, wall, runway_utilization(ap, seconds));
+        } else {
+            pthread_join(monitor_thread, NULL);
+        }
+        /* operations in flight are finished first, so that the airport and the statistics are complete */
+        flights_stop(f);
+        scheduler_destroy(s);
+        for (int i = 0; i < num_actors; ++i)
+            flights_get_rng(f, i, streams + 4 * i);
+        flights_destroy(f);
+        logger_destroy();
+        stop_trace(&cfg);
+        save_checkpoint(&cfg, current_timestamp(), streams, num_actors);
+        free(streams);
 
-    for (int i = 0; i < NUM_LANDING_THREADS; ++i) {
-        pthread_create(&landing_thread[i], &attr, (void *(*)(void *)) landing_thread_func, (void *) ((uintptr_t) landprob));
+        /* print the airport and the latencies before exiting */
+        if (cfg.benchmark) {
+            printf("%s", c);
+            free(c);
+        } else {
+            airport_print(ap, stdout);
+            c = stats_to_string();
+            printf("%s", c);
+            free(c);
+            print_lockstat();
+        }
+        airport_destroy(ap);
+        stats_destroy();
+        destroy_arrivals();
+        return 0;
     }
 
-    for (int i = 0; i < NUM_TAKEOFF_THREADS; ++i) {
-        pthread_create(&takeoff_thread[i], &attr, (void *(*)(void *)) takeoff_thread_func, (void *) ((uintptr_t) takeoffprob));
+    pthread_t *landing_thread = malloc(cfg.num_landing * sizeof(pthread_t));
+    pthread_t *takeoff_thread = malloc(cfg.num_takeoff * sizeof(pthread_t));
+    worker_args *landing_args = malloc(cfg.num_landing * sizeof(worker_args));
+    worker_args *takeoff_args = malloc(cfg.num_takeoff * sizeof(worker_args));
+
+    for (int i = 0; i < cfg.num_landing; ++i) {
+        landing_args[i].process = &landing_process;
+        landing_args[i].stream = 1 + i;
+        landing_args[i].restored = i < num_restored;
+        landing_args[i].rng = streams + 4 * i;
+        pthread_create(&landing_thread[i], &attr, (void *(*)(void *)) landing_thread_func, &landing_args[i]);
+    }
+
+    for (int i = 0; i < cfg.num_takeoff; ++i) {
+        takeoff_args[i].process = &takeoff_process;
+        takeoff_args[i].stream = 1 + cfg.num_landing + i;
+        takeoff_args[i].restored = cfg.num_landing + i < num_restored;
+        takeoff_args[i].rng = streams + 4 * (cfg.num_landing + i);
+        pthread_create(&takeoff_thread[i], &attr, (void *(*)(void *)) takeoff_thread_func, &takeoff_args[i]);
+    }
+
+    if (cfg.benchmark) {
+        /* the report is taken when the benchmark ends, not after the threads finished their last operation */
+        double wall = run_benchmark(&cfg);
+        double seconds = wall * cfg.speed;
+        c = benchmark_to_string(&cfg, seconds, wall, runway_utilization(ap, seconds));
+    } else {
+        pthread_join(monitor_thread, NULL);
     }
 
-    /* wait for all three threads to finish their work */
-    pthread_join(monitor_thread, NULL);
-    for (int i = 0; i < NUM_LANDING_THREADS; ++i) {
+    /* wait for all threads to finish their work */
+    for (int i = 0; i < cfg.num_landing; ++i) {
         pthread_join(landing_thread[i], NULL);
     }
-    for (int i = 0; i < NUM_TAKEOFF_THREADS; ++i) {
+    for (int i = 0; i < cfg.num_takeoff; ++i) {
         pthread_join(takeoff_thread[i], NULL);
     }
+    logger_destroy();
+    stop_trace(&cfg);
+    save_checkpoint(&cfg, current_timestamp(), streams, num_actors);
+    free(streams);
+    free(landing_thread);
+    free(takeoff_thread);
+    free(landing_args);
+    free(takeoff_args);
 
-    /* print the airport before exiting */
-    char *c = airport_to_string(ap);
-    printf("%s", c);
-    free(c);
+    /* print the airport and the latencies before exiting */
+    if (cfg.benchmark) {
+        printf("%s", c);
+        free(c);
+    } else {
+        airport_print(ap, stdout);
+        c = stats_to_string();
+        printf("%s", c);
+        free(c);
+        print_lockstat();
+    }
 
     /* free the airport object */
     airport_destroy(ap);
+    stats_destroy();
+    destroy_arrivals();
 
     return 0;
 }
-
-
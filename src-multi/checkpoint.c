@@ -0,0 +1,225 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file checkpoint.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the saving and restoring of airport checkpoints.
+ *
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "checkpoint.h"
+#include "plane.h"
+#include "tools.h"
+#include "wire.h"
+
+/**
+ * @brief Magic number at the start of a checkpoint file, including the terminating zero byte
+ *
+ * */
+#define CHECKPOINT_MAGIC "ASCHKPT"
+
+/**
+ * @brief Version of the file format
+ *
+ * */
+#define CHECKPOINT_VERSION 2
+
+/**
+ * @brief Size of the file header in bytes
+ *
+ * */
+#define CHECKPOINT_HEADER_SIZE 80
+
+/**
+ * @brief Size of a runway record in bytes
+ *
+ * */
+#define CHECKPOINT_RUNWAY_SIZE 16
+
+/**
+ * @brief Size of a plane record in bytes
+ *
+ * */
+#define CHECKPOINT_PLANE_SIZE 24
+
+/**
+ * @brief Size of the record of an actor's random number generator in bytes
+ *
+ * */
+#define CHECKPOINT_STREAM_SIZE 32
+
+/**
+ * @brief Checkpoint structure for representing an instance of a mapped checkpoint file
+ *
+ */
+struct checkpoint {
+    uint8_t *data; /**< The mapped file. */
+    size_t size; /**< Size of the file. */
+    int num_bays; /**< Number of bays. */
+    int num_runways; /**< Number of runways. */
+    int num_planes; /**< Number of parked planes. */
+    int num_streams; /**< Number of saved generators of actors. */
+};
+
+bool checkpoint_save(const char *path, airport *ap, time_t now, uint64_t seed, const uint64_t *streams,
+                     int num_streams) {
+    int num_bays = airport_get_num_bays(ap);
+    int num_runways = airport_get_num_runways(ap);
+    size_t size = CHECKPOINT_HEADER_SIZE + (size_t) num_runways * CHECKPOINT_RUNWAY_SIZE +
+                  (size_t) num_bays * CHECKPOINT_PLANE_SIZE + (size_t) num_streams * CHECKPOINT_STREAM_SIZE;
+    uint8_t *buf = (uint8_t *) calloc(size, 1);
+
+    uint8_t *p = buf + CHECKPOINT_HEADER_SIZE;
+    for (int i = 0; i < num_runways; ++i) {
+        unsigned long operations;
+        time_t busy_time;
+        airport_get_runway_stats(ap, i, &operations, &busy_time);
+        wire_put_u64(p, operations);
+        wire_put_u64(p + 8, busy_time);
+        p += CHECKPOINT_RUNWAY_SIZE;
+    }
+    uint32_t num_planes = 0;
+    for (int i = 0; i < num_bays; ++i) {
+        char name[8];
+        time_t parked_at;
+        int runway;
+        if (!airport_get_parked_plane(ap, i, name, &parked_at, &runway))
+            continue;
+        wire_put_u32(p, i);
+        wire_put_u32(p + 4, runway);
+        wire_put_u64(p + 8, now - parked_at);
+        memcpy(p + 16, name, sizeof(name));
+        p += CHECKPOINT_PLANE_SIZE;
+        num_planes++;
+    }
+    for (int i = 0; i < 4 * num_streams; ++i, p += 8)
+        wire_put_u64(p, streams[i]);
+
+    uint64_t rng[4];
+    rng_get_state(rng);
+    memcpy(buf, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    wire_put_u32(buf + 8, CHECKPOINT_VERSION);
+    wire_put_u32(buf + 12, num_bays);
+    wire_put_u32(buf + 16, num_runways);
+    wire_put_u32(buf + 20, num_planes);
+    wire_put_u64(buf + 24, now);
+    wire_put_u64(buf + 32, seed);
+    for (int i = 0; i < 4; ++i)
+        wire_put_u64(buf + 40 + 8 * i, rng[i]);
+    wire_put_u32(buf + 72, num_streams);
+
+    FILE *f = fopen(path, "wb");
+    bool ok = f != NULL && fwrite(buf, 1, p - buf, f) == (size_t) (p - buf);
+    if (f != NULL && fclose(f) != 0)
+        ok = false;
+    free(buf);
+    return ok;
+}
+
+checkpoint *checkpoint_init(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < CHECKPOINT_HEADER_SIZE) {
+        close(fd);
+        return NULL;
+    }
+    uint8_t *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return NULL;
+    checkpoint *c = (checkpoint *) malloc(sizeof(checkpoint));
+    c->data = data;
+    c->size = st.st_size;
+    c->num_bays = wire_get_u32(data + 12);
+    c->num_runways = wire_get_u32(data + 16);
+    c->num_planes = wire_get_u32(data + 20);
+    c->num_streams = wire_get_u32(data + 72);
+    if (memcmp(data, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 ||
+        wire_get_u32(data + 8) != CHECKPOINT_VERSION || c->num_bays <= 0 || c->num_runways <= 0 ||
+        c->num_planes < 0 || c->num_planes > c->num_bays || c->num_streams < 0 ||
+        c->size != CHECKPOINT_HEADER_SIZE + (size_t) c->num_runways * CHECKPOINT_RUNWAY_SIZE +
+                   (size_t) c->num_planes * CHECKPOINT_PLANE_SIZE + (size_t) c->num_streams * CHECKPOINT_STREAM_SIZE) {
+        checkpoint_destroy(c);
+        return NULL;
+    }
+    return c;
+}
+
+int checkpoint_get_num_bays(checkpoint *c) {
+    return c->num_bays;
+}
+
+int checkpoint_get_num_runways(checkpoint *c) {
+    return c->num_runways;
+}
+
+int checkpoint_get_num_planes(checkpoint *c) {
+    return c->num_planes;
+}
+
+time_t checkpoint_get_time(checkpoint *c) {
+    return (time_t) wire_get_u64(c->data + 24);
+}
+
+uint64_t checkpoint_get_seed(checkpoint *c) {
+    return wire_get_u64(c->data + 32);
+}
+
+int checkpoint_get_num_streams(checkpoint *c) {
+    return c->num_streams;
+}
+
+void checkpoint_get_stream(checkpoint *c, int i, uint64_t *state) {
+    const uint8_t *p = c->data + CHECKPOINT_HEADER_SIZE + (size_t) c->num_runways * CHECKPOINT_RUNWAY_SIZE +
+                       (size_t) c->num_planes * CHECKPOINT_PLANE_SIZE + (size_t) i * CHECKPOINT_STREAM_SIZE;
+    for (int j = 0; j < 4; ++j)
+        state[j] = wire_get_u64(p + 8 * j);
+}
+
+bool checkpoint_restore(checkpoint *c, airport *ap, time_t now) {
+    const uint8_t *p = c->data + CHECKPOINT_HEADER_SIZE;
+    for (int i = 0; i < c->num_runways && i < airport_get_num_runways(ap); ++i) {
+        airport_set_runway_stats(ap, i, wire_get_u64(p), wire_get_u64(p + 8));
+        p += CHECKPOINT_RUNWAY_SIZE;
+    }
+    p = c->data + CHECKPOINT_HEADER_SIZE + (size_t) c->num_runways * CHECKPOINT_RUNWAY_SIZE;
+    bool ok = c->num_runways == airport_get_num_runways(ap);
+    for (int i = 0; i < c->num_planes; ++i, p += CHECKPOINT_PLANE_SIZE) {
+        char name[8];
+        memcpy(name, p + 16, sizeof(name));
+        name[7] = '\0';
+        uint32_t runway = wire_get_u32(p + 4);
+        plane *pl = plane_init_named(name);
+        if (runway >= (uint32_t) airport_get_num_runways(ap) ||
+            !airport_restore_plane(ap, wire_get_u32(p), pl, runway, now - (time_t) wire_get_u64(p + 8))) {
+            plane_destroy(pl);
+            ok = false;
+        }
+    }
+
+    uint64_t rng[4];
+    for (int i = 0; i < 4; ++i)
+        rng[i] = wire_get_u64(c->data + 40 + 8 * i);
+    rng_set_state(rng);
+    return ok;
+}
+
+void checkpoint_destroy(checkpoint *c) {
+    munmap(c->data, c->size);
+    free(c);
+}
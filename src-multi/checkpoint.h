@@ -0,0 +1,144 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file checkpoint.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible methods of airport checkpoints.
+ *
+ * A checkpoint holds the state of an airport at one point in time: the parked planes with their bay, runway and
+ * parking age, the usage of the runways, the time of the checkpoint, the master seed, the state of the random
+ * number generator of the saving thread, which drives the discrete-event simulation, and the states of the generators
+ * of the landing and take-off actors of the realtime modes, which draw from their own streams. Planes, which were
+ * landing or taking off, are not part of it, their bays and runways are free after restoring.
+ *
+ * The file consists of fixed-size little-endian records, so that it is used directly from memory: an 80 byte header
+ * ("ASCHKPT" and a zero byte, format version, number of bays, runways and planes as 32 bit numbers, time, seed and
+ * the four words of the generator as 64 bit numbers, number of actors' generators and a zero as 32 bit numbers), 16
+ * bytes per runway (operations and busy time as 64 bit numbers), 24 bytes per plane (bay and runway as 32 bit
+ * numbers, parking age in milliseconds as 64 bit number and the name in 8 bytes) and 32 bytes per actor's generator
+ * (its four words as 64 bit numbers).
+ *
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "airport.h"
+
+/**
+ * @brief Forward declaration for checkpoint
+ *
+ * */
+typedef struct checkpoint checkpoint;
+
+/**
+ * @brief Writes a checkpoint of an airport
+ * @param char* Path of the file
+ * @param airport* The airport, which should not change while it is saved
+ * @param time_t Current time, of the simulation in virtual time, parking ages are taken relative to it
+ * @param uint64_t Master seed of the run
+ * @param uint64_t* States of the generators of the actors, four words each, or NULL if there are none
+ * @param int Number of actors' generators
+ * @return True, if the file has been written, false otherwise
+ *
+ * The state of the random number generator of the calling thread is saved as well.
+ *
+ * */
+bool checkpoint_save(const char *, airport *, time_t, uint64_t, const uint64_t *, int);
+
+/**
+ * @brief constructor for checkpoint
+ * @param char* Path of the checkpoint file, which is mapped into memory
+ * @return A pointer to the checkpoint structure, or NULL if the file cannot be read or is no checkpoint
+ *
+ * After using this structure, it must be freed with checkpoint_destroy(checkpoint *)
+ *
+ * */
+checkpoint *checkpoint_init(const char *);
+
+/**
+ * @brief Gets the number of bays of the saved airport
+ * @param checkpoint* Pointer to structure to work on
+ * @return Number of bays
+ *
+ * */
+int checkpoint_get_num_bays(checkpoint *);
+
+/**
+ * @brief Gets the number of runways of the saved airport
+ * @param checkpoint* Pointer to structure to work on
+ * @return Number of runways
+ *
+ * */
+int checkpoint_get_num_runways(checkpoint *);
+
+/**
+ * @brief Gets the number of parked planes of the saved airport
+ * @param checkpoint* Pointer to structure to work on
+ * @return Number of planes
+ *
+ * */
+int checkpoint_get_num_planes(checkpoint *);
+
+/**
+ * @brief Gets the time the checkpoint was taken at
+ * @param checkpoint* Pointer to structure to work on
+ * @return The time, which was passed to checkpoint_save()
+ *
+ * */
+time_t checkpoint_get_time(checkpoint *);
+
+/**
+ * @brief Gets the master seed of the saved run
+ * @param checkpoint* Pointer to structure to work on
+ * @return The seed
+ *
+ * */
+uint64_t checkpoint_get_seed(checkpoint *);
+
+/**
+ * @brief Gets the number of saved generators of actors
+ * @param checkpoint* Pointer to structure to work on
+ * @return Number of generators, 0 if the saved run was in virtual time
+ *
+ * */
+int checkpoint_get_num_streams(checkpoint *);
+
+/**
+ * @brief Gets the saved generator of an actor
+ * @param checkpoint* Pointer to structure to work on
+ * @param int Index of the actor, landing actors first, less than checkpoint_get_num_streams()
+ * @param uint64_t* Receives the state, four words, to be passed to rng_set_state()
+ *
+ * */
+void checkpoint_get_stream(checkpoint *, int, uint64_t *);
+
+/**
+ * @brief Restores the state into an airport
+ * @param checkpoint* Pointer to structure to work on
+ * @param airport* An empty airport with the bays and runways of the checkpoint
+ * @param time_t Current time, the planes keep their parking age relative to it
+ * @return True, if all planes could be parked, false if the checkpoint does not fit the airport
+ *
+ * The random number generator of the calling thread continues where the saving one stopped.
+ *
+ * */
+bool checkpoint_restore(checkpoint *, airport *, time_t);
+
+/**
+ * @brief Destructor for checkpoint
+ * @param checkpoint* Pointer to structure to be freed
+ *
+ * */
+void checkpoint_destroy(checkpoint *);
+
+#endif /* CHECKPOINT_H */
@@ -0,0 +1,399 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file cluster.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods of the cluster of processes.
+ *
+ * For TCP, every node listens on its port, connects to all nodes before it in the list and accepts the connections of
+ * all nodes after it. A connecting node first sends its index, so that the accepting node knows who it is.
+ *
+ */
+
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "cluster.h"
+#include "tools.h"
+#include "wire.h"
+
+/**
+ * @brief Number of attempts to connect to a node, which is not listening yet
+ *
+ * */
+#define CLUSTER_CONNECT_ATTEMPTS 300
+
+/**
+ * @brief Milliseconds between two attempts to connect
+ *
+ * */
+#define CLUSTER_CONNECT_DELAY 100
+
+/**
+ * @brief Cluster structure for representing the connections of a process to the others
+ *
+ */
+struct cluster {
+    int index; /**< Index of this process. */
+    int size; /**< Number of processes. */
+    int *fds; /**< Socket connected to every other process, -1 for this one. */
+    pid_t *children; /**< Forked processes, in process 0 of a forked cluster only, otherwise NULL. */
+};
+
+/**
+ * @brief State of the transfer of one frame to or from a process
+ *
+ * */
+typedef struct transfer {
+    uint8_t header[4]; /**< Length of the frame. */
+    uint8_t *data; /**< Payload of the frame. */
+    size_t len; /**< Length of the payload. */
+    size_t done; /**< Bytes transferred so far, including the header. */
+} transfer;
+
+/**
+ * @brief Terminates the process after a failed socket operation
+ * @param char* Name of the operation
+ *
+ * */
+static void fail(const char *what) {
+    perror(what);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Sends a part of a frame
+ * @param int The socket
+ * @param transfer* The frame
+ * @param int Flags of send()
+ * @return False, if the socket would block
+ *
+ * */
+static bool send_part(int fd, transfer *t, int flags) {
+    const uint8_t *p = t->done < 4 ? t->header + t->done : t->data + (t->done - 4);
+    size_t left = t->done < 4 ? 4 - t->done : t->len - (t->done - 4);
+    ssize_t n = send(fd, p, left, flags | MSG_NOSIGNAL);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return false;
+        fail("cluster send");
+    }
+    t->done += n;
+    return true;
+}
+
+/**
+ * @brief Receives a part of a frame
+ * @param int The socket
+ * @param transfer* The frame, the payload is allocated, when the header is complete
+ * @param int Flags of recv()
+ * @return False, if the socket would block
+ *
+ * */
+static bool recv_part(int fd, transfer *t, int flags) {
+    uint8_t *p = t->done < 4 ? t->header + t->done : t->data + (t->done - 4);
+    size_t left = t->done < 4 ? 4 - t->done : t->len - (t->done - 4);
+    ssize_t n = recv(fd, p, left, flags);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return false;
+        fail("cluster recv");
+    }
+    if (n == 0) {
+        fprintf(stderr, "cluster: connection closed by peer\n");
+        exit(EXIT_FAILURE);
+    }
+    t->done += n;
+    if (t->done == 4) {
+        t->len = wire_get_u32(t->header);
+        t->data = malloc(t->len ? t->len : 1);
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if a frame has been transferred completely
+ * @param transfer* The frame
+ * @return True, if header and payload are done
+ *
+ * */
+static bool transfer_done(transfer *t) {
+    return t->done >= 4 && t->done == 4 + t->len;
+}
+
+/**
+ * @brief Allocates a cluster without connections
+ * @param int Index of this process
+ * @param int Number of processes
+ * @return The cluster
+ *
+ * */
+static cluster *cluster_alloc(int index, int size) {
+    cluster *c = (cluster *) malloc(sizeof(cluster));
+    c->index = index;
+    c->size = size;
+    c->fds = (int *) malloc(size * sizeof(int));
+    for (int i = 0; i < size; ++i)
+        c->fds[i] = -1;
+    c->children = NULL;
+    return c;
+}
+
+cluster *cluster_fork(int size) {
+    /* one socket pair for every pair of processes, fds[i][j] is the end of process i */
+    int *pairs = (int *) malloc(size * size * sizeof(int));
+    for (int i = 0; i < size; ++i) {
+        pairs[i * size + i] = -1;
+        for (int j = i + 1; j < size; ++j) {
+            int sv[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0)
+                fail("socketpair");
+            pairs[i * size + j] = sv[0];
+            pairs[j * size + i] = sv[1];
+        }
+    }
+
+    /* buffered output would be written by every process */
+    fflush(stdout);
+    int index = 0;
+    pid_t *children = (pid_t *) malloc(size * sizeof(pid_t));
+    for (int i = 1; i < size; ++i) {
+        children[i] = fork();
+        if (children[i] < 0)
+            fail("fork");
+        if (children[i] == 0) {
+            index = i;
+            break;
+        }
+    }
+
+    cluster *c = cluster_alloc(index, size);
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            if (i == j)
+                continue;
+            if (i == index)
+                c->fds[j] = pairs[i * size + j];
+            else
+                close(pairs[i * size + j]);
+        }
+    }
+    free(pairs);
+    if (index == 0)
+        c->children = children;
+    else
+        free(children);
+    return c;
+}
+
+/**
+ * @brief Resolves a "host:port" of the list of nodes
+ * @param char* The node, is changed in place
+ * @param bool True for an address to listen on
+ * @return The addresses, to be freed with freeaddrinfo(), or NULL if the node is invalid
+ *
+ * */
+static struct addrinfo *resolve(char *node, bool passive) {
+    char *colon = strrchr(node, ':');
+    if (colon == NULL)
+        return NULL;
+    *colon = '\0';
+    struct addrinfo hints, *res;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    int err = getaddrinfo(*node ? node : NULL, colon + 1, &hints, &res);
+    *colon = ':';
+    if (err != 0) {
+        fprintf(stderr, "%s: %s\n", node, gai_strerror(err));
+        return NULL;
+    }
+    return res;
+}
+
+/**
+ * @brief Turns off the delay of small segments of a TCP connection
+ * @param int The socket
+ *
+ * Batches are sent at once, waiting for more data would only add latency to every window.
+ *
+ * */
+static void set_nodelay(int fd) {
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+cluster *cluster_connect(int index, const char *peers) {
+    /* split the list into nodes */
+    char *list = strdup(peers);
+    int size = 1;
+    for (char *p = list; *p; ++p)
+        size += *p == ',';
+    char **nodes = (char **) malloc(size * sizeof(char *));
+    char *save;
+    int n = 0;
+    for (char *tok = strtok_r(list, ",", &save); tok; tok = strtok_r(NULL, ",", &save))
+        nodes[n++] = tok;
+    cluster *c = NULL;
+    if (n != size || index < 0 || index >= size)
+        goto out;
+
+    struct addrinfo *res = resolve(nodes[index], true);
+    if (res == NULL)
+        goto out;
+    int lfd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    int on = 1;
+    if (lfd < 0 || setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) < 0 || bind(lfd, res->ai_addr, res->ai_addrlen) < 0 || listen(lfd, size) < 0)
+        fail("cluster listen");
+    freeaddrinfo(res);
+
+    c = cluster_alloc(index, size);
+    for (int i = 0; i < index; ++i) {
+        res = resolve(nodes[i], false);
+        if (res == NULL)
+            fail("cluster connect");
+        int fd = -1;
+        for (int attempt = 0; fd < 0 && attempt < CLUSTER_CONNECT_ATTEMPTS; ++attempt) {
+            fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+            if (connect(fd, res->ai_addr, res->ai_addrlen) < 0) {
+                /* the node has not started listening yet */
+                close(fd);
+                fd = -1;
+                msleep(CLUSTER_CONNECT_DELAY);
+            }
+        }
+        freeaddrinfo(res);
+        if (fd < 0)
+            fail(nodes[i]);
+        set_nodelay(fd);
+        c->fds[i] = fd;
+        uint8_t hello[4];
+        wire_put_u32(hello, index);
+        cluster_send(c, i, hello, sizeof(hello));
+    }
+    for (int i = index + 1; i < size; ++i) {
+        int fd = accept(lfd, NULL, NULL);
+        if (fd < 0)
+            fail("cluster accept");
+        set_nodelay(fd);
+        transfer t;
+        memset(&t, 0, sizeof(t));
+        while (!transfer_done(&t))
+            recv_part(fd, &t, 0);
+        uint32_t peer = t.len == 4 ? wire_get_u32(t.data) : 0;
+        free(t.data);
+        if (peer <= (uint32_t) index || peer >= (uint32_t) size || c->fds[peer] >= 0) {
+            fprintf(stderr, "cluster: unexpected node %u\n", peer);
+            exit(EXIT_FAILURE);
+        }
+        c->fds[peer] = fd;
+    }
+    close(lfd);
+
+out:
+    free(nodes);
+    free(list);
+    return c;
+}
+
+int cluster_get_index(cluster *c) {
+    return c->index;
+}
+
+int cluster_get_size(cluster *c) {
+    return c->size;
+}
+
+void cluster_send(cluster *c, int peer, const uint8_t *data, size_t len) {
+    transfer t;
+    wire_put_u32(t.header, (uint32_t) len);
+    t.data = (uint8_t *) data;
+    t.len = len;
+    t.done = 0;
+    while (!transfer_done(&t))
+        send_part(c->fds[peer], &t, 0);
+}
+
+uint8_t *cluster_recv(cluster *c, int peer, size_t *len) {
+    transfer t;
+    memset(&t, 0, sizeof(t));
+    while (!transfer_done(&t))
+        recv_part(c->fds[peer], &t, 0);
+    *len = t.len;
+    return t.data;
+}
+
+void cluster_exchange(cluster *c, uint8_t **out, const size_t *out_len, uint8_t **in, size_t *in_len) {
+    transfer *tx = (transfer *) calloc(c->size, sizeof(transfer));
+    transfer *rx = (transfer *) calloc(c->size, sizeof(transfer));
+    struct pollfd *fds = (struct pollfd *) malloc(c->size * sizeof(struct pollfd));
+    for (int i = 0; i < c->size; ++i) {
+        wire_put_u32(tx[i].header, (uint32_t) out_len[i]);
+        tx[i].data = out[i];
+        tx[i].len = out_len[i];
+    }
+
+    for (;;) {
+        int n = 0;
+        for (int i = 0; i < c->size; ++i) {
+            if (i == c->index)
+                continue;
+            short events = (transfer_done(&tx[i]) ? 0 : POLLOUT) | (transfer_done(&rx[i]) ? 0 : POLLIN);
+            if (events) {
+                fds[n].fd = c->fds[i];
+                fds[n].events = events;
+                n++;
+            }
+        }
+        if (n == 0)
+            break;
+        if (poll(fds, n, -1) < 0 && errno != EINTR)
+            fail("cluster poll");
+        for (int k = 0; k < n; ++k) {
+            int i = 0;
+            while (c->fds[i] != fds[k].fd)
+                ++i;
+            if ((fds[k].revents & (POLLOUT | POLLERR)) && !transfer_done(&tx[i]))
+                send_part(fds[k].fd, &tx[i], MSG_DONTWAIT);
+            if ((fds[k].revents & (POLLIN | POLLHUP | POLLERR)) && !transfer_done(&rx[i]))
+                recv_part(fds[k].fd, &rx[i], MSG_DONTWAIT);
+        }
+    }
+
+    for (int i = 0; i < c->size; ++i) {
+        in[i] = i == c->index ? NULL : rx[i].data;
+        in_len[i] = i == c->index ? 0 : rx[i].len;
+    }
+    free(fds);
+    free(rx);
+    free(tx);
+}
+
+void cluster_destroy(cluster *c) {
+    for (int i = 0; i < c->size; ++i) {
+        if (c->fds[i] >= 0)
+            close(c->fds[i]);
+    }
+    if (c->children) {
+        for (int i = 1; i < c->size; ++i)
+            waitpid(c->children[i], NULL, 0);
+        free(c->children);
+    }
+    free(c->fds);
+    free(c);
+}
@@ -0,0 +1,119 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file cluster.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible methods of the cluster of processes.
+ *
+ * A cluster is a group of processes, each connected to every other by a stream socket. Either the processes are forked
+ * from one, connected by Unix domain sockets, or they are started separately, maybe on several machines, and connect
+ * over TCP. Process 0 is the one, which was started by the user, or the first of the list of nodes.
+ *
+ * Messages are frames of a 4 byte little-endian length followed by the payload. A failing connection terminates the
+ * process, as the cluster cannot go on without one of its processes.
+ *
+ */
+
+#ifndef CLUSTER_H
+#define CLUSTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Forward declaration for cluster
+ *
+ * */
+typedef struct cluster cluster;
+
+/**
+ * @brief constructor for a cluster of local processes
+ * @param int Number of processes
+ * @return A pointer to the cluster structure, in every process
+ *
+ * Forks the other processes, connected by Unix domain sockets. The function returns in every process of the cluster,
+ * which tell themselves apart by cluster_get_index(cluster *). The calling process must not run other threads yet.
+ *
+ * After using this structure, it must be freed with cluster_destroy(cluster *)
+ *
+ * */
+cluster *cluster_fork(int);
+
+/**
+ * @brief constructor for a cluster of processes, which connect over TCP
+ * @param int Index of the calling process in the list of nodes
+ * @param char* Comma separated list of "host:port" of all nodes, the calling one listens on its own port
+ * @return A pointer to the cluster structure, or NULL if the list is invalid or a node cannot be reached
+ *
+ * Waits until all nodes of the list are connected.
+ *
+ * After using this structure, it must be freed with cluster_destroy(cluster *)
+ *
+ * */
+cluster *cluster_connect(int, const char *);
+
+/**
+ * @brief Gets the index of the calling process
+ * @param cluster* Pointer to structure to work on
+ * @return Index of the process, 0 to cluster_get_size(cluster *) - 1
+ *
+ * */
+int cluster_get_index(cluster *);
+
+/**
+ * @brief Gets the number of processes
+ * @param cluster* Pointer to structure to work on
+ * @return Number of processes
+ *
+ * */
+int cluster_get_size(cluster *);
+
+/**
+ * @brief Sends a message to one process
+ * @param cluster* Pointer to structure to work on
+ * @param int Index of the receiving process
+ * @param uint8_t* The message
+ * @param size_t Length of the message
+ *
+ * */
+void cluster_send(cluster *, int, const uint8_t *, size_t);
+
+/**
+ * @brief Receives a message from one process
+ * @param cluster* Pointer to structure to work on
+ * @param int Index of the sending process
+ * @param size_t* Receives the length of the message
+ * @return The message. Has to be freed by caller.
+ *
+ * */
+uint8_t *cluster_recv(cluster *, int, size_t *);
+
+/**
+ * @brief Sends one message to every other process and receives one from every other process
+ * @param cluster* Pointer to structure to work on
+ * @param uint8_t** Message for every process, the entry of the calling process is ignored
+ * @param size_t* Length of the message for every process
+ * @param uint8_t** Receives the message of every other process, which has to be freed by caller
+ * @param size_t* Receives the length of the message of every other process
+ *
+ * Sending and receiving are interleaved, so that processes exchanging large messages do not block each other.
+ *
+ * */
+void cluster_exchange(cluster *, uint8_t **, const size_t *, uint8_t **, size_t *);
+
+/**
+ * @brief Destructor for cluster
+ * @param cluster* Pointer to structure to be freed
+ *
+ * Closes the connections. In process 0 of a forked cluster, waits for the other processes to exit.
+ *
+ * */
+void cluster_destroy(cluster *);
+
+#endif /* CLUSTER_H */
@@ -0,0 +1,277 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file config.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the run-time configuration of the simulation.
+ *
+ */
+
+#include <ctype.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "airport.h"
+#include "arrival.h"
+#include "config.h"
+#include "logger.h"
+#include "timesource.h"
+
+/**
+ * @brief Upper limit for the number of bays, runways and actors
+ *
+ * */
+#define CONFIG_MAX_COUNT 1000000
+
+/**
+ * @brief Maximum length of a line of a configuration file
+ *
+ * */
+#define CONFIG_LINE_SIZE 256
+
+/**
+ * @brief Parses a whole string as a number in a range
+ * @param char* The string
+ * @param long Smallest valid number
+ * @param long Largest valid number
+ * @param long* Receives the number
+ * @return True, if the string is a number in the range, false otherwise
+ *
+ * */
+static bool parse_long(const char *value, long min, long max, long *out) {
+    char *end;
+    long l = strtol(value, &end, 0);
+    if (end == value || *end != '\0' || l < min || l > max)
+        return false;
+    *out = l;
+    return true;
+}
+
+/**
+ * @brief Parses a whole string as a number in a range into an int
+ * @param char* The string
+ * @param long Smallest valid number
+ * @param long Largest valid number
+ * @param int* Receives the number
+ * @return True, if the string is a number in the range, false otherwise
+ *
+ * */
+static bool parse_int(const char *value, long min, long max, int *out) {
+    long l;
+    if (!parse_long(value, min, max, &l))
+        return false;
+    *out = (int) l;
+    return true;
+}
+
+/**
+ * @brief Parses a string as a boolean
+ * @param char* The string: yes, true or 1, or no, false or 0
+ * @param bool* Receives the boolean
+ * @return True, if the string is a boolean, false otherwise
+ *
+ * */
+static bool parse_bool(const char *value, bool *out) {
+    if (!strcmp(value, "yes") || !strcmp(value, "true") || !strcmp(value, "1"))
+        *out = true;
+    else if (!strcmp(value, "no") || !strcmp(value, "false") || !strcmp(value, "0"))
+        *out = false;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Copies a string setting
+ * @param char* The value
+ * @param char* Receives the value, has CONFIG_STRING_SIZE bytes
+ * @return True, if the value fits, false otherwise
+ *
+ * */
+static bool parse_string(const char *value, char *out) {
+    if (strlen(value) >= CONFIG_STRING_SIZE)
+        return false;
+    strcpy(out, value);
+    return true;
+}
+
+/**
+ * @brief Removes leading and trailing white space from a string
+ * @param char* The string, which is changed in place
+ * @return Pointer to the first character, which is no white space
+ *
+ * */
+static char *trim(char *s) {
+    while (isspace((unsigned char) *s))
+        ++s;
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char) end[-1]))
+        --end;
+    *end = '\0';
+    return s;
+}
+
+void config_defaults(config *cfg) {
+    cfg->mode = CONFIG_REALTIME;
+    cfg->landprob = 50;
+    cfg->takeoffprob = 50;
+    strcpy(cfg->landing_arrivals, "tick");
+    strcpy(cfg->takeoff_arrivals, "tick");
+    cfg->num_bays = AIRPORT_DEFAULT_BAYS;
+    cfg->num_runways = AIRPORT_DEFAULT_RUNWAYS;
+    cfg->num_landing = 15;
+    cfg->num_takeoff = 5;
+    cfg->workers = 0;
+    cfg->num_airports = 8;
+    cfg->num_shards = 0;
+    cfg->flight_minutes = 30;
+    cfg->processes = 1;
+    cfg->node = 0;
+    cfg->peers[0] = '\0';
+    cfg->trace[0] = '\0';
+    cfg->replay[0] = '\0';
+    cfg->checkpoint[0] = '\0';
+    cfg->restore[0] = '\0';
+    cfg->seconds = 86400;
+    cfg->benchmark = false;
+    cfg->events = 0;
+    cfg->lockstat = false;
+    cfg->clock = TIMESOURCE_MONOTONIC;
+    cfg->speed = 1;
+    cfg->seed = time(NULL);
+    cfg->loglevel = -1;
+}
+
+bool config_set(config *cfg, const char *name, const char *value) {
+    if (!strcmp(name, "mode")) {
+        if (!strcmp(value, "realtime"))
+            cfg->mode = CONFIG_REALTIME;
+        else if (!strcmp(value, "tasks"))
+            cfg->mode = CONFIG_TASKS;
+        else if (!strcmp(value, "virtual"))
+            cfg->mode = CONFIG_VIRTUAL;
+        else if (!strcmp(value, "network"))
+            cfg->mode = CONFIG_NETWORK;
+        else
+            return false;
+        return true;
+    }
+    if (!strcmp(name, "landing_probability"))
+        return parse_int(value, 1, 90, &cfg->landprob);
+    if (!strcmp(name, "takeoff_probability"))
+        return parse_int(value, 1, 90, &cfg->takeoffprob);
+    if (!strcmp(name, "landing_arrivals") || !strcmp(name, "takeoff_arrivals") || !strcmp(name, "arrivals")) {
+        if (arrival_parse(value) < 0 || strlen(value) >= CONFIG_STRING_SIZE)
+            return false;
+        if (strcmp(name, "takeoff_arrivals") != 0)
+            strcpy(cfg->landing_arrivals, value);
+        if (strcmp(name, "landing_arrivals") != 0)
+            strcpy(cfg->takeoff_arrivals, value);
+        return true;
+    }
+    if (!strcmp(name, "bays"))
+        return parse_int(value, 1, CONFIG_MAX_COUNT, &cfg->num_bays);
+    if (!strcmp(name, "runways"))
+        return parse_int(value, 1, CONFIG_MAX_COUNT, &cfg->num_runways);
+    if (!strcmp(name, "landing_actors"))
+        return parse_int(value, 0, CONFIG_MAX_COUNT, &cfg->num_landing);
+    if (!strcmp(name, "takeoff_actors"))
+        return parse_int(value, 0, CONFIG_MAX_COUNT, &cfg->num_takeoff);
+    if (!strcmp(name, "workers"))
+        return parse_int(value, 0, CONFIG_MAX_COUNT, &cfg->workers);
+    if (!strcmp(name, "airports"))
+        return parse_int(value, 1, CONFIG_MAX_COUNT, &cfg->num_airports);
+    if (!strcmp(name, "shards"))
+        return parse_int(value, 0, CONFIG_MAX_COUNT, &cfg->num_shards);
+    if (!strcmp(name, "processes"))
+        return parse_int(value, 1, 1024, &cfg->processes);
+    if (!strcmp(name, "node"))
+        return parse_int(value, 0, 1023, &cfg->node);
+    if (!strcmp(name, "peers"))
+        return parse_string(value, cfg->peers);
+    if (!strcmp(name, "trace"))
+        return parse_string(value, cfg->trace);
+    if (!strcmp(name, "checkpoint"))
+        return parse_string(value, cfg->checkpoint);
+    if (!strcmp(name, "restore"))
+        return parse_string(value, cfg->restore);
+    if (!strcmp(name, "replay")) {
+        if (!parse_string(value, cfg->replay))
+            return false;
+        cfg->mode = CONFIG_REPLAY;
+        return true;
+    }
+    if (!strcmp(name, "flight_time"))
+        return parse_int(value, 1, 24 * 60, &cfg->flight_minutes);
+    if (!strcmp(name, "duration"))
+        return parse_long(value, 0, LONG_MAX / 1000, &cfg->seconds);
+    if (!strcmp(name, "benchmark"))
+        return parse_bool(value, &cfg->benchmark);
+    if (!strcmp(name, "lockstat"))
+        return parse_bool(value, &cfg->lockstat);
+    if (!strcmp(name, "events")) {
+        long events;
+        if (!parse_long(value, 0, LONG_MAX, &events))
+            return false;
+        cfg->events = events;
+        return true;
+    }
+    if (!strcmp(name, "clock")) {
+        int source = timesource_parse(value);
+        if (source < 0)
+            return false;
+        cfg->clock = source;
+        return true;
+    }
+    if (!strcmp(name, "speed"))
+        return parse_int(value, 1, TIMESOURCE_MAX_SPEED, &cfg->speed);
+    if (!strcmp(name, "seed")) {
+        char *end;
+        unsigned long long seed = strtoull(value, &end, 0);
+        if (end == value || *end != '\0')
+            return false;
+        cfg->seed = seed;
+        return true;
+    }
+    if (!strcmp(name, "log")) {
+        int level = logger_parse_level(value);
+        if (level < 0)
+            return false;
+        cfg->loglevel = level;
+        return true;
+    }
+    return false;
+}
+
+bool config_load(config *cfg, const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "%s: cannot open configuration file\n", path);
+        return false;
+    }
+    char line[CONFIG_LINE_SIZE];
+    bool ok = true;
+    for (int nr = 1; fgets(line, sizeof(line), f) != NULL; ++nr) {
+        char *name = trim(line);
+        if (*name == '\0' || *name == '#')
+            continue;
+        char *eq = strchr(name, '=');
+        if (eq != NULL) {
+            *eq = '\0';
+            if (config_set(cfg, trim(name), trim(eq + 1)))
+                continue;
+        }
+        fprintf(stderr, "%s:%d: invalid setting\n", path, nr);
+        ok = false;
+    }
+    fclose(f);
+    return ok;
+}
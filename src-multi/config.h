@@ -0,0 +1,108 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file config.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the run-time configuration of the simulation.
+ *
+ * Every setting has a name and can be given on the command line or in a configuration file with one
+ * "name = value" pair per line. Empty lines and lines starting with '#' are ignored.
+ *
+ */
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Maximum length of the list of peers and of file names
+ *
+ * */
+#define CONFIG_STRING_SIZE 256
+
+/**
+ * @brief Simulation modes
+ *
+ * */
+enum {
+    CONFIG_REALTIME, /**< One thread per landing and take-off actor, in real time. */
+    CONFIG_TASKS, /**< Actors run as tasks on a pool of workers, in real time. */
+    CONFIG_VIRTUAL, /**< Discrete-event simulation in virtual time. */
+    CONFIG_NETWORK, /**< Discrete-event simulation of a network of airports on several threads. */
+    CONFIG_REPLAY /**< Replay of a trace file. */
+};
+
+/**
+ * @brief Run-time configuration of the simulation
+ *
+ * */
+typedef struct config {
+    int mode; /**< Simulation mode, one of CONFIG_REALTIME, CONFIG_TASKS, CONFIG_VIRTUAL, CONFIG_NETWORK or CONFIG_REPLAY. */
+    int landprob; /**< Landing probability per tick in percent. */
+    int takeoffprob; /**< Take-off probability per tick in percent. */
+    char landing_arrivals[CONFIG_STRING_SIZE]; /**< Arrival process of the landing actors, see arrival.h. */
+    char takeoff_arrivals[CONFIG_STRING_SIZE]; /**< Arrival process of the take-off actors, see arrival.h. */
+    int num_bays; /**< Number of parking bays of the airport. */
+    int num_runways; /**< Number of runways of the airport. */
+    int num_landing; /**< Number of landing actors. */
+    int num_takeoff; /**< Number of take-off actors. */
+    int workers; /**< Number of worker threads in tasks mode, 0 for one per processor. */
+    int num_airports; /**< Number of airports in network mode. */
+    int num_shards; /**< Number of threads in network mode, 0 for one per processor. */
+    int processes; /**< Number of local processes running the network, ignored if peers are set. */
+    int node; /**< Index of this process in peers. */
+    char peers[CONFIG_STRING_SIZE]; /**< Comma separated "host:port" of the processes running the network over TCP. */
+    int flight_minutes; /**< Shortest flight time between two airports in minutes, flights take up to twice as long. */
+    long seconds; /**< Simulated seconds in virtual mode, seconds to run in benchmark mode. */
+    bool benchmark; /**< Runs without user interaction and prints a machine-readable report. */
+    unsigned long events; /**< In benchmark mode, stops after this many landings and take-offs, 0 for no limit. */
+    bool lockstat; /**< Profiles the contention of the locks. */
+    int clock; /**< Clock of all timestamps, one of TIMESOURCE_MONOTONIC, TIMESOURCE_COARSE or TIMESOURCE_TSC. */
+    int speed; /**< Factor the realtime modes run faster than real time. */
+    uint64_t seed; /**< Master seed of the random number generators. */
+    char trace[CONFIG_STRING_SIZE]; /**< File the trace of the airport's events is written to, empty for no trace. */
+    char replay[CONFIG_STRING_SIZE]; /**< Trace file replayed in replay mode. */
+    char checkpoint[CONFIG_STRING_SIZE]; /**< File the airport is saved to at the end, empty for none. */
+    char restore[CONFIG_STRING_SIZE]; /**< Checkpoint file the airport starts from, empty for an empty airport. */
+    int loglevel; /**< Log level, or -1 for the default of the mode. */
+} config;
+
+/**
+ * @brief Sets all settings to their defaults
+ * @param config* Pointer to structure to work on
+ *
+ * */
+void config_defaults(config *);
+
+/**
+ * @brief Sets a setting by name
+ * @param config* Pointer to structure to work on
+ * @param char* Name of the setting
+ * @param char* Value of the setting
+ * @return True, if the setting exists and the value is valid, false otherwise
+ *
+ * The setting is not changed, if the value is invalid.
+ *
+ * */
+bool config_set(config *, const char *, const char *);
+
+/**
+ * @brief Reads settings from a configuration file
+ * @param config* Pointer to structure to work on
+ * @param char* Path of the configuration file
+ * @return True, if all settings of the file are valid, false otherwise
+ *
+ * Invalid lines are reported on stderr. Settings, which are not in the file, are left as they are.
+ *
+ * */
+bool config_load(config *, const char *);
+
+#endif /* CONFIG_H */
@@ -0,0 +1,113 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file eventqueue.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods for eventqueue class.
+ *
+ * The event queue is implemented as a binary min-heap in a growing array.
+ *
+ */
+
+#include <stdlib.h>
+#include "eventqueue.h"
+
+/**
+* @brief Initial number of events the queue can hold before growing
+*
+*/
+#define EVENTQUEUE_INITIAL_CAPACITY 64
+
+/**
+* @brief Eventqueue structure for representing an instance of an event queue
+*
+*/
+struct eventqueue {
+    event *heap; /**< Binary min-heap of events, ordered by time and seq. */
+    unsigned long size; /**< Number of events in the heap. */
+    unsigned long capacity; /**< Number of events the heap can hold. */
+    unsigned long next_seq; /**< Insertion number for the next pushed event. */
+};
+
+/**
+* @brief Compares two events
+* @param event* First event
+* @param event* Second event
+* @return True, if the first event has to fire before the second one
+*
+* */
+static bool event_before(const event *a, const event *b) {
+    if (a->time != b->time)
+        return a->time < b->time;
+    return a->seq < b->seq;
+}
+
+eventqueue *eventqueue_init() {
+    eventqueue *eq = (eventqueue *) malloc(sizeof(eventqueue));
+    eq->capacity = EVENTQUEUE_INITIAL_CAPACITY;
+    eq->heap = (event *) malloc(eq->capacity * sizeof(event));
+    eq->size = 0;
+    eq->next_seq = 0;
+    return eq;
+}
+
+void eventqueue_push(eventqueue *eq, time_t time, int type, unsigned int gen, void *data) {
+    if (eq->size == eq->capacity) {
+        eq->capacity *= 2;
+        eq->heap = (event *) realloc(eq->heap, eq->capacity * sizeof(event));
+    }
+    event e = {.time = time, .seq = eq->next_seq++, .type = type, .gen = gen, .data = data};
+
+    /* sift up */
+    unsigned long i = eq->size++;
+    while (i > 0) {
+        unsigned long parent = (i - 1) / 2;
+        if (!event_before(&e, &eq->heap[parent]))
+            break;
+        eq->heap[i] = eq->heap[parent];
+        i = parent;
+    }
+    eq->heap[i] = e;
+}
+
+bool eventqueue_pop(eventqueue *eq, event *out) {
+    if (eq->size == 0)
+        return false;
+    *out = eq->heap[0];
+
+    /* sift the last event down from the root */
+    event last = eq->heap[--eq->size];
+    unsigned long i = 0;
+    while (1) {
+        unsigned long child = 2 * i + 1;
+        if (child >= eq->size)
+            break;
+        if (child + 1 < eq->size && event_before(&eq->heap[child + 1], &eq->heap[child]))
+            child++;
+        if (!event_before(&eq->heap[child], &last))
+            break;
+        eq->heap[i] = eq->heap[child];
+        i = child;
+    }
+    eq->heap[i] = last;
+    return true;
+}
+
+time_t eventqueue_peek_time(eventqueue *eq) {
+    return eq->size ? eq->heap[0].time : -1;
+}
+
+unsigned long eventqueue_size(eventqueue *eq) {
+    return eq->size;
+}
+
+void eventqueue_destroy(eventqueue *eq) {
+    free(eq->heap);
+    free(eq);
+}
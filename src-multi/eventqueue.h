@@ -0,0 +1,97 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file eventqueue.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible event queue methods.
+ *
+ * The event queue is a priority queue of events keyed on their virtual timestamp. It drives the discrete-event
+ * simulation. Events with the same timestamp are returned in the order they were pushed.
+ *
+ */
+
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include <stdbool.h>
+#include <time.h>
+
+/**
+ * @brief A single event of the simulation
+ *
+ * */
+typedef struct event {
+    time_t time; /**< Virtual timestamp in milliseconds, at which the event fires. */
+    unsigned long seq; /**< Insertion number, to keep events with the same timestamp in FIFO order. */
+    int type; /**< Type of the event, interpreted by the owner of the queue. */
+    unsigned int gen; /**< Generation of the target at push time, to detect outdated events. */
+    void *data; /**< Target of the event. */
+} event;
+
+/**
+ * @brief Forward declaration for eventqueue
+ *
+ * */
+typedef struct eventqueue eventqueue;
+
+/**
+ * @brief constructor for eventqueue
+ * @return A pointer to the eventqueue structure, representing the created object
+ *
+ * After using this structure, it must be freed with eventqueue_destroy(eventqueue *)
+ *
+ * */
+eventqueue *eventqueue_init();
+
+/**
+ * @brief Adds an event to the queue
+ * @param eventqueue* Pointer to structure to work on
+ * @param time_t Virtual timestamp of the event
+ * @param int Type of the event
+ * @param unsigned-int Generation of the target
+ * @param void* Target of the event
+ *
+ * The queue grows as needed. This is not thread safe.
+ *
+ * */
+void eventqueue_push(eventqueue *, time_t, int, unsigned int, void *);
+
+/**
+ * @brief Removes the earliest event from the queue
+ * @param eventqueue* Pointer to structure to work on
+ * @param event* Is filled with the removed event
+ * @return False, if the queue is empty, true otherwise
+ *
+ * */
+bool eventqueue_pop(eventqueue *, event *);
+
+/**
+ * @brief Gets the timestamp of the earliest event without removing it
+ * @param eventqueue* Pointer to structure to work on
+ * @return The timestamp of the earliest event, or -1 if the queue is empty
+ *
+ * */
+time_t eventqueue_peek_time(eventqueue *);
+
+/**
+ * @brief Gets the number of queued events
+ * @param eventqueue* Pointer to structure to work on
+ * @return The number of events in the queue
+ *
+ * */
+unsigned long eventqueue_size(eventqueue *);
+
+/**
+ * @brief Destructor for eventqueue
+ * @param eventqueue* Pointer to structure to be freed
+ *
+ * */
+void eventqueue_destroy(eventqueue *);
+
+#endif /* EVENTQUEUE_H */
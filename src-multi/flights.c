@@ -0,0 +1,371 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file flights.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing the actors of the task based simulation.
+ *
+ * Each actor is a small state machine. Every step runs as one task and hands the actor on to exactly one next step, a
+ * scheduled task or a place in one of the airport's queues, so an actor is never run by two workers at the same time
+ * and needs no lock of its own. The timing mirrors the threaded simulation: the actor wakes up as its arrival process
+ * says, waits in line up to 5 seconds, and spends 2 seconds on the runway.
+ *
+ */
+
+#include <sched.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "cancel.h"
+#include "flights.h"
+#include "logger.h"
+#include "stats.h"
+#include "tools.h"
+
+/**
+* @brief Time a plane occupies the runway for landing or take-off in milliseconds
+*
+*/
+#define FLIGHT_RUNWAY_MS 2000
+
+/**
+* @brief Maximum time an operation waits for a bay, plane or runway in milliseconds
+*
+*/
+#define FLIGHT_TIMEOUT_MS 5000
+
+/**
+* @brief States of an actor
+*
+*/
+enum {
+    FLIGHT_IDLE, /**< The actor waits until it wakes up next. */
+    FLIGHT_WAIT_BAY, /**< The landing actor waits for a free bay. */
+    FLIGHT_WAIT_PLANE, /**< The take-off actor waits for a parked plane. */
+    FLIGHT_WAIT_RUNWAY, /**< The actor waits for a free runway. */
+    FLIGHT_ON_RUNWAY /**< The actor's plane is landing or taking off. */
+};
+
+/**
+* @brief Actor structure for representing a landing or take-off actor
+*
+*/
+typedef struct flight_actor {
+    flights *f; /**< The simulation the actor belongs to. */
+    bool landing; /**< True for landing actors, false for take-off actors. */
+    const arrival *process; /**< Arrival process deciding when the actor operates. */
+    int state; /**< Current state of the actor. */
+    time_t wake_at; /**< Time the actor was due to wake up last, which its next wake up is counted from. */
+    time_t deadline; /**< Time at which the current operation is given up. */
+    time_t wait_start; /**< Time the actor started waiting for its current resource. */
+    plane *plane; /**< Plane which is landing or taking off, NULL if there is none. */
+    int bay_nr; /**< Bay reserved by the current operation. */
+    int runway; /**< Runway used by the current operation. */
+    bool on_runway; /**< The plane is on the runway, whoever clears this first finishes the operation. */
+    admission_waiter waiter; /**< Place of the actor in the queue it waits in. */
+    int queue; /**< Queue the actor waits in, -1 if it is in none, read by the timers with atomic operations. */
+    uint64_t rng[4]; /**< State of the actor's own random number generator. */
+} flight_actor;
+
+/**
+* @brief Flights structure for representing an instance of the task based simulation
+*
+*/
+struct flights {
+    scheduler *s; /**< Scheduler the actors run on. */
+    airport *ap; /**< The simulated airport. */
+    flight_actor *actors; /**< All actors. */
+    int num_actors; /**< Length of actors. */
+    int busy; /**< Number of actors in the middle of an operation, changed with atomic operations. */
+};
+
+/**
+* @brief Runs the next step of an actor as a task
+* @param flight_actor* The actor
+*
+* */
+static void step(flight_actor *a);
+
+/**
+* @brief Runs the next step of an actor, with its random number generator in place
+* @param flight_actor* The actor
+*
+* */
+static void advance(flight_actor *a);
+
+/**
+* @brief Schedules the next step of an actor
+* @param flight_actor* The actor
+* @param time_t Time in milliseconds as returned by current_timestamp()
+*
+* */
+static void step_at(flight_actor *a, time_t time) {
+    /* saved before the actor is handed on, as the next step may start at once on another worker */
+    rng_get_state(a->rng);
+    scheduler_submit_at(a->f->s, time, (task_fn) step, a);
+}
+
+/**
+* @brief Schedules the step, in which the actor wakes up next
+* @param flight_actor* The actor
+*
+* */
+static void sleep_until_next(flight_actor *a) {
+    a->wake_at = arrival_next_at(a->process, a->wake_at, current_timestamp());
+    step_at(a, a->wake_at);
+}
+
+/**
+* @brief Ends the current operation of an actor
+* @param flight_actor* The actor
+*
+* After cancellation, the actor does not start another operation.
+*
+* */
+static void end_operation(flight_actor *a) {
+    a->state = FLIGHT_IDLE;
+    if (!cancel_requested())
+        sleep_until_next(a);
+    __atomic_sub_fetch(&a->f->busy, 1, __ATOMIC_RELEASE);
+}
+
+/**
+* @brief Lands or takes off the plane on the runway
+* @param flight_actor* The actor, which won the on_runway flag
+*
+* */
+static void clear_runway(flight_actor *a) {
+    airport *ap = a->f->ap;
+    airport_release_runway(ap, a->runway);
+    if (a->landing) {
+        airport_park_plane(ap, a->bay_nr, a->plane, a->runway);
+        logger_event(LOGGER_PARKED, plane_get_name(a->plane), a->bay_nr, a->runway, 0);
+        stats_count(STATS_LANDINGS);
+    } else {
+        logger_event(LOGGER_DEPARTED, plane_get_name(a->plane), a->bay_nr, a->runway, 0);
+        plane_destroy(a->plane);
+        airport_release_bay(ap, a->bay_nr);
+        stats_count(STATS_TAKEOFFS);
+    }
+    a->plane = NULL;
+}
+
+/**
+* @brief Gives up the current operation
+* @param flight_actor* The actor
+*
+* */
+static void give_up(flight_actor *a) {
+    airport *ap = a->f->ap;
+    bool timeout = !cancel_requested();
+    if (timeout)
+        stats_count(STATS_TIMEOUTS);
+    if (a->state == FLIGHT_WAIT_RUNWAY) {
+        if (a->landing) {
+            /* the plane is turned away and the bay is free again */
+            if (timeout)
+                logger_event(LOGGER_TURNED_AWAY, plane_get_name(a->plane), a->bay_nr, -1, 0);
+            plane_destroy(a->plane);
+            a->plane = NULL;
+            airport_release_bay(ap, a->bay_nr);
+        } else {
+            /* the plane stays in its bay */
+            if (timeout)
+                logger_event(LOGGER_STAYED, NULL, -1, -1, 0);
+            airport_unclaim_plane(ap);
+        }
+    }
+    end_operation(a);
+}
+
+/**
+* @brief Called back by a queue, when the actor got its unit or had to leave the queue
+* @param flight_actor* The actor
+*
+* */
+static void resume(flight_actor *a) {
+    scheduler_submit(a->f->s, (task_fn) step, a);
+}
+
+/**
+* @brief Takes the actor out of its queue, when the deadline of its operation has passed
+* @param flight_actor* The actor
+*
+* A timer, whose actor got its unit in the meantime, does not find it in the queue and does nothing. So does a timer
+* of an earlier wait, which finds the actor queued with a later deadline.
+*
+* */
+static void expire(flight_actor *a) {
+    int queue = __atomic_load_n(&a->queue, __ATOMIC_RELAXED);
+    if (queue >= 0 && airport_expire(a->f->ap, queue, &a->waiter, current_timestamp()))
+        step(a);
+}
+
+/**
+* @brief Waits in line of one of the airport's queues
+* @param flight_actor* The actor
+* @param int The queue, AIRPORT_BAYS, AIRPORT_PLANES or AIRPORT_RUNWAYS
+* @return True, if the actor holds a unit of the queue, false if it waits now or gave up its operation
+*
+* The actor is resumed in the same state, when it got its unit, when its deadline passed, or when cancellation was
+* requested.
+*
+* */
+static bool wait_in_line(flight_actor *a, int queue) {
+    if (a->queue == queue) {
+        __atomic_store_n(&a->queue, -1, __ATOMIC_RELAXED);
+        if (a->waiter.granted)
+            return true;
+    }
+    if (cancel_requested() || current_timestamp() >= a->deadline) {
+        give_up(a);
+        return false;
+    }
+    scheduler *s = a->f->s;
+    time_t deadline = a->deadline;
+    rng_get_state(a->rng);
+    a->waiter.deadline = deadline;
+    __atomic_store_n(&a->queue, queue, __ATOMIC_RELAXED);
+    if (airport_enqueue(a->f->ap, queue, &a->waiter)) {
+        __atomic_store_n(&a->queue, -1, __ATOMIC_RELAXED);
+        return true;
+    }
+    /* the actor may already run on another worker, it must not be touched anymore */
+    scheduler_submit_at(s, deadline, (task_fn) expire, a);
+    return false;
+}
+
+static void step(flight_actor *a) {
+    /* the actor draws from its own stream, whichever worker runs it, so that the stream can be checkpointed */
+    uint64_t worker[4];
+    rng_get_state(worker);
+    rng_set_state(a->rng);
+    advance(a);
+    rng_set_state(worker);
+}
+
+static void advance(flight_actor *a) {
+    airport *ap = a->f->ap;
+    switch (a->state) {
+        case FLIGHT_IDLE:
+            if (cancel_requested())
+                return;
+            if (!arrival_fires(a->process)) {
+                sleep_until_next(a);
+                return;
+            }
+            __atomic_add_fetch(&a->f->busy, 1, __ATOMIC_RELAXED);
+            a->wait_start = current_timestamp();
+            a->deadline = a->wait_start + FLIGHT_TIMEOUT_MS;
+            a->state = a->landing ? FLIGHT_WAIT_BAY : FLIGHT_WAIT_PLANE;
+            advance(a);
+            return;
+        case FLIGHT_WAIT_BAY:
+            if (!wait_in_line(a, AIRPORT_BAYS))
+                return;
+            a->bay_nr = airport_take_bay(ap);
+            a->plane = plane_init();
+            stats_record(STATS_BAY_WAIT, current_timestamp() - a->wait_start);
+            a->wait_start = current_timestamp();
+            a->state = FLIGHT_WAIT_RUNWAY;
+            advance(a);
+            return;
+        case FLIGHT_WAIT_PLANE:
+            if (!wait_in_line(a, AIRPORT_PLANES))
+                return;
+            stats_record(STATS_PLANE_WAIT, current_timestamp() - a->wait_start);
+            a->wait_start = current_timestamp();
+            a->state = FLIGHT_WAIT_RUNWAY;
+            advance(a);
+            return;
+        case FLIGHT_WAIT_RUNWAY:
+            if (!wait_in_line(a, AIRPORT_RUNWAYS))
+                return;
+            a->runway = airport_take_runway(ap);
+            stats_record(STATS_RUNWAY_WAIT, current_timestamp() - a->wait_start);
+            if (a->landing) {
+                logger_event(LOGGER_LANDING, plane_get_name(a->plane), a->bay_nr, a->runway, 0);
+            } else {
+                a->plane = airport_unpark_plane(ap, &a->bay_nr);
+                if (logger_enabled(LOGGER_TAKEOFF))
+                    logger_event(LOGGER_TAKEOFF, plane_get_name(a->plane), a->bay_nr, a->runway,
+                                 airport_get_bay_time(ap, a->bay_nr));
+            }
+            a->state = FLIGHT_ON_RUNWAY;
+            __atomic_store_n(&a->on_runway, true, __ATOMIC_RELEASE);
+            step_at(a, current_timestamp() + FLIGHT_RUNWAY_MS);
+            return;
+        case FLIGHT_ON_RUNWAY:
+            /* on shutdown, flights_stop() may have finished the operation already */
+            if (!__atomic_exchange_n(&a->on_runway, false, __ATOMIC_ACQUIRE))
+                return;
+            clear_runway(a);
+            end_operation(a);
+            return;
+    }
+}
+
+flights *flights_init(scheduler *s, airport *ap, const arrival *landing, const arrival *takeoff, int num_landing,
+                      int num_takeoff, const uint64_t *rng, int num_rng) {
+    flights *f = (flights *) malloc(sizeof(flights));
+    f->s = s;
+    f->ap = ap;
+    f->num_actors = num_landing + num_takeoff;
+    f->busy = 0;
+    f->actors = (flight_actor *) calloc(f->num_actors, sizeof(flight_actor));
+    uint64_t saved[4];
+    rng_get_state(saved);
+    for (int i = 0; i < f->num_actors; ++i) {
+        flight_actor *a = &f->actors[i];
+        a->f = f;
+        a->landing = i < num_landing;
+        a->process = a->landing ? landing : takeoff;
+        a->state = FLIGHT_IDLE;
+        a->queue = -1;
+        admission_waiter_init(&a->waiter, (admission_fn) resume, a);
+        /* the same streams as the threads of the threaded simulation */
+        if (i < num_rng)
+            rng_set_state(rng + 4 * i);
+        else
+            rng_thread_init(1 + i);
+        long long first = arrival_first(a->process);
+        rng_get_state(a->rng);
+        a->wake_at = current_timestamp() + first;
+        if (first > 0)
+            scheduler_submit_at(s, a->wake_at, (task_fn) step, a);
+        else
+            scheduler_submit(s, (task_fn) step, a);
+    }
+    rng_set_state(saved);
+    return f;
+}
+
+void flights_get_rng(flights *f, int i, uint64_t *state) {
+    memcpy(state, f->actors[i].rng, sizeof(f->actors[i].rng));
+}
+
+void flights_stop(flights *f) {
+    while (__atomic_load_n(&f->busy, __ATOMIC_ACQUIRE) > 0) {
+        /* planes on a runway are parked or gone at once, like in the threaded simulation */
+        for (int i = 0; i < f->num_actors; ++i) {
+            flight_actor *a = &f->actors[i];
+            if (__atomic_exchange_n(&a->on_runway, false, __ATOMIC_ACQUIRE)) {
+                clear_runway(a);
+                __atomic_sub_fetch(&f->busy, 1, __ATOMIC_RELEASE);
+            }
+        }
+        /* waiting actors were called back by their queues and give up as soon as they run */
+        sched_yield();
+    }
+}
+
+void flights_destroy(flights *f) {
+    free(f->actors);
+    free(f);
+}
@@ -0,0 +1,86 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file flights.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible methods of the task based simulation.
+ *
+ * The task based simulation runs the landing and take-off actors of the threaded simulation as tasks on a scheduler,
+ * in real time. An actor never blocks a thread: it waits for a bay, plane or runway in the same queue as the threads,
+ * which calls it back when its turn comes, and occupying the runway is a task scheduled for when the runway is free
+ * again. Thousands of actors therefore cost memory, not kernel threads.
+ *
+ */
+
+#ifndef FLIGHTS_H
+#define FLIGHTS_H
+
+#include <stdint.h>
+#include "airport.h"
+#include "arrival.h"
+#include "scheduler.h"
+
+/**
+ * @brief Forward declaration for flights
+ *
+ * */
+typedef struct flights flights;
+
+/**
+ * @brief constructor for flights
+ * @param scheduler* Scheduler the actors run on
+ * @param airport* The airport to simulate
+ * @param arrival* Arrival process of the landing actors, which must exist as long as the flights
+ * @param arrival* Arrival process of the take-off actors, which must exist as long as the flights
+ * @param int Number of landing actors
+ * @param int Number of take-off actors
+ * @param uint64_t* States of the actors' random number generators to continue, four words each, or NULL
+ * @param int Number of states, the other actors start streams derived from the master seed
+ * @return A pointer to the flights structure, representing the created object
+ *
+ * All actors are started right away. Each actor draws from its own generator, whichever worker runs it.
+ * After using this structure, it must be stopped with flights_stop(flights *) and freed with
+ * flights_destroy(flights *), after the scheduler was destroyed.
+ *
+ * */
+flights *flights_init(scheduler *, airport *, const arrival *, const arrival *, int, int, const uint64_t *, int);
+
+/**
+ * @brief Lets the actors finish their operations after cancellation was requested
+ * @param flights* Pointer to structure to work on
+ *
+ * Waiting actors give up, planes on a runway are parked or gone at once, as in the threaded simulation, so that no
+ * bay, plane or runway stays claimed. No actor starts another operation. Returns when no actor is in an operation
+ * anymore, the scheduler can be destroyed then.
+ *
+ * */
+void flights_stop(flights *);
+
+/**
+ * @brief Gets the state of an actor's random number generator
+ * @param flights* Pointer to structure to work on
+ * @param int Index of the actor, landing actors first
+ * @param uint64_t* Receives the state, four words
+ *
+ * The scheduler must have been destroyed before, so that no actor is running.
+ *
+ * */
+void flights_get_rng(flights *, int, uint64_t *);
+
+/**
+ * @brief Destructor for flights
+ * @param flights* Pointer to structure to be freed
+ *
+ * The actors must have been stopped and the scheduler destroyed before, so that no actor is running. The airport
+ * itself is not freed.
+ *
+ * */
+void flights_destroy(flights *);
+
+#endif /* FLIGHTS_H */
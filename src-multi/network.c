@@ -0,0 +1,617 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file network.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods for the airport network simulation.
+ *
+ * A window covers the virtual time (start, end]. A flight departing in it arrives at least one window length later,
+ * so after the end of the window. At the end of every window, the shards wait at a barrier, and afterwards collect
+ * all flights of the window from their rings. While a shard waits, at the barrier or for room in a full ring, it keeps
+ * emptying its own rings, so shards never wait for each other in a cycle.
+ *
+ * Flights are kept in a pending list and inserted into the simulation of their destination at the start of the window
+ * they arrive in, sorted by arrival time, origin and departure order. Flights of the running window may already be in
+ * the list then, but never arrive within it, so they are not inserted yet.
+ *
+ * In a cluster of processes, the last shard reaching the barrier sends the flights to other processes in one batch per
+ * process, and passes the flights it receives on to the shards of their destinations, before it releases the others.
+ * A batch starts with the end of the window and the number of flights, followed by the flights: arrival time relative
+ * to the end of the window, origin, destination, departure number and name, all as variable-length integers but the
+ * name, which is its length and its characters.
+ *
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "network.h"
+#include "airport.h"
+#include "cluster.h"
+#include "ring.h"
+#include "sim.h"
+#include "strbuf.h"
+#include "tools.h"
+#include "wire.h"
+
+/**
+ * @brief Number of flights a ring between two shards can hold
+ *
+ * */
+#define NETWORK_RING_SIZE 1024
+
+/**
+ * @brief Stream number of the random number generator of the first airport
+ *
+ * */
+#define NETWORK_RNG_STREAM (1 << 20)
+
+/**
+ * @brief Size of a cache line in bytes
+ *
+ * */
+#define CACHE_LINE 64
+
+/**
+ * @brief A flight from one airport to another
+ *
+ * */
+typedef struct flight_msg {
+    time_t when; /**< Arrival time at the destination. */
+    unsigned long seq; /**< Number of the flight among all flights of its origin. */
+    int src; /**< Origin airport. */
+    int dst; /**< Destination airport. */
+    char name[8]; /**< Name of the plane. */
+} flight_msg;
+
+/**
+ * @brief A growable list of flights
+ *
+ * */
+typedef struct flight_list {
+    flight_msg *items; /**< The flights. */
+    size_t len; /**< Number of flights. */
+    size_t size; /**< Allocated length of items. */
+} flight_list;
+
+/**
+ * @brief An airport of the network with its simulation
+ *
+ * */
+typedef struct node {
+    network *n; /**< The network. */
+    int id; /**< Number of the airport. */
+    airport *ap; /**< The airport, NULL if it is run by another process. */
+    sim *s; /**< Simulation of the airport, NULL if it is run by another process. */
+    uint64_t rng[4]; /**< State of the airport's random number generator, while it is not running. */
+    unsigned long seq; /**< Number of flights, which departed from the airport. */
+} node;
+
+/**
+ * @brief A shard runs some airports in one thread
+ *
+ * */
+typedef struct shard {
+    network *n; /**< The network. */
+    int id; /**< Number of the shard. */
+    pthread_t thread; /**< Thread running the shard. */
+    flight_list pending; /**< Flights to the shard's airports, which have not been inserted yet. */
+    flight_list *remote; /**< Flights to the airports of every other process, which have not been sent yet. */
+    unsigned long sent; /**< Number of flights sent to other shards of the process. */
+    unsigned long sent_remote; /**< Number of flights sent to other processes. */
+    char pad[CACHE_LINE]; /**< Keeps neighbouring shards on different cache lines. */
+} shard;
+
+/**
+ * @brief Network structure for representing an instance of the airport network simulation
+ *
+ */
+struct network {
+    int num_airports; /**< Number of airports. */
+    int num_shards; /**< Number of shards of this process. */
+    cluster *cl; /**< Processes running the network, NULL if it runs in this process only. */
+    int proc; /**< Index of this process. */
+    int num_procs; /**< Number of processes. */
+    node *nodes; /**< All airports, airport i is run by process i % num_procs, in shard i / num_procs % num_shards. */
+    shard *shards; /**< All shards. */
+    ring **rings; /**< Ring from shard i to shard j at i * num_shards + j, NULL for i == j. */
+    time_t window; /**< Length of a window, the shortest flight time, in milliseconds. */
+    time_t now; /**< Virtual time all shards have reached. */
+    time_t end; /**< Virtual time the current run ends. */
+    unsigned int barrier_count; /**< Number of shards waiting at the barrier. */
+    unsigned int barrier_gen; /**< Incremented whenever all shards reached the barrier. */
+};
+
+/**
+ * @brief Appends a flight to a list
+ * @param flight_list* The list
+ * @param flight_msg* The flight
+ *
+ * */
+static void list_add(flight_list *l, const flight_msg *msg) {
+    if (l->len == l->size) {
+        l->size = l->size ? 2 * l->size : 64;
+        l->items = realloc(l->items, l->size * sizeof(flight_msg));
+    }
+    l->items[l->len++] = *msg;
+}
+
+/**
+ * @brief Gets the shard of this process, which runs an airport
+ * @param network* The network
+ * @param int Number of the airport, which has to be run by this process
+ * @return Number of the shard
+ *
+ * */
+static int shard_of(network *n, int airport) {
+    return airport / n->num_procs % n->num_shards;
+}
+
+/**
+ * @brief Moves the flights from the rings of all other shards to the pending list
+ * @param shard* The shard, which has to be run by the calling thread
+ *
+ * */
+static void drain(shard *sh) {
+    network *n = sh->n;
+    flight_msg msg;
+    for (int src = 0; src < n->num_shards; ++src) {
+        if (src == sh->id)
+            continue;
+        ring *r = n->rings[src * n->num_shards + sh->id];
+        while (ring_pop(r, &msg))
+            list_add(&sh->pending, &msg);
+    }
+}
+
+/**
+ * @brief Passes a flight on to the shard of its destination
+ * @param shard* The shard of the calling thread
+ * @param flight_msg* The flight, its destination has to be run by this process
+ *
+ * */
+static void route(shard *sh, const flight_msg *msg) {
+    network *n = sh->n;
+    int dst_shard = shard_of(n, msg->dst);
+    if (dst_shard == sh->id) {
+        list_add(&sh->pending, msg);
+        return;
+    }
+    ring *r = n->rings[sh->id * n->num_shards + dst_shard];
+    while (!ring_push(r, msg)) {
+        /* the destination may be waiting for room in one of our rings */
+        drain(sh);
+        sched_yield();
+    }
+}
+
+/**
+ * @brief Encodes the flights of all shards to one process
+ * @param network* The network
+ * @param int The process
+ * @param time_t End of the window
+ * @param size_t* Receives the length of the batch
+ * @return The batch. Has to be freed by caller.
+ *
+ * */
+static uint8_t *encode_batch(network *n, int proc, time_t end, size_t *len) {
+    size_t count = 0;
+    for (int i = 0; i < n->num_shards; ++i)
+        count += n->shards[i].remote[proc].len;
+    uint8_t *buf = malloc(2 * WIRE_VARINT_MAX + count * (5 * WIRE_VARINT_MAX + sizeof(((flight_msg *) 0)->name)));
+    uint8_t *p = buf;
+    p += wire_put_varint(p, end);
+    p += wire_put_varint(p, count);
+    for (int i = 0; i < n->num_shards; ++i) {
+        flight_list *l = &n->shards[i].remote[proc];
+        for (size_t k = 0; k < l->len; ++k) {
+            flight_msg *msg = &l->items[k];
+            size_t name_len = strlen(msg->name);
+            p += wire_put_varint(p, msg->when - end);
+            p += wire_put_varint(p, msg->src);
+            p += wire_put_varint(p, msg->dst);
+            p += wire_put_varint(p, msg->seq);
+            p += wire_put_varint(p, name_len);
+            memcpy(p, msg->name, name_len);
+            p += name_len;
+        }
+        n->shards[i].sent_remote += l->len;
+        l->len = 0;
+    }
+    *len = p - buf;
+    return buf;
+}
+
+/**
+ * @brief Decodes a batch of flights from another process and passes them on to their shards
+ * @param shard* The shard of the calling thread
+ * @param uint8_t* The batch
+ * @param size_t Length of the batch
+ * @param time_t End of the window
+ *
+ * */
+static void decode_batch(shard *sh, const uint8_t *buf, size_t len, time_t end) {
+    network *n = sh->n;
+    const uint8_t *p = buf, *stop = buf + len;
+    uint64_t batch_end, count, when, src, dst, seq, name_len;
+    if (!wire_get_varint(&p, stop, &batch_end) || (time_t) batch_end != end || !wire_get_varint(&p, stop, &count))
+        goto invalid;
+    for (uint64_t k = 0; k < count; ++k) {
+        flight_msg msg;
+        if (!wire_get_varint(&p, stop, &when) || !wire_get_varint(&p, stop, &src) ||
+            !wire_get_varint(&p, stop, &dst) || !wire_get_varint(&p, stop, &seq) ||
+            !wire_get_varint(&p, stop, &name_len))
+            goto invalid;
+        if (src >= (uint64_t) n->num_airports || dst >= (uint64_t) n->num_airports ||
+            (int) dst % n->num_procs != n->proc || name_len >= sizeof(msg.name) || (size_t) (stop - p) < name_len)
+            goto invalid;
+        msg.when = end + when;
+        msg.src = src;
+        msg.dst = dst;
+        msg.seq = seq;
+        memset(msg.name, 0, sizeof(msg.name));
+        memcpy(msg.name, p, name_len);
+        p += name_len;
+        route(sh, &msg);
+    }
+    return;
+
+invalid:
+    fprintf(stderr, "network: invalid batch of flights\n");
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Exchanges the flights of a window with all other processes
+ * @param shard* The shard of the calling thread, while all other shards wait at the barrier
+ * @param time_t End of the window
+ *
+ * */
+static void exchange(shard *sh, time_t end) {
+    network *n = sh->n;
+    uint8_t **out = calloc(n->num_procs, sizeof(uint8_t *));
+    uint8_t **in = calloc(n->num_procs, sizeof(uint8_t *));
+    size_t *out_len = calloc(n->num_procs, sizeof(size_t));
+    size_t *in_len = calloc(n->num_procs, sizeof(size_t));
+    for (int i = 0; i < n->num_procs; ++i) {
+        if (i != n->proc)
+            out[i] = encode_batch(n, i, end, &out_len[i]);
+    }
+    cluster_exchange(n->cl, out, out_len, in, in_len);
+    for (int i = 0; i < n->num_procs; ++i) {
+        if (i == n->proc)
+            continue;
+        decode_batch(sh, in[i], in_len[i], end);
+        free(in[i]);
+        free(out[i]);
+    }
+    free(in_len);
+    free(out_len);
+    free(in);
+    free(out);
+}
+
+/**
+ * @brief Waits until all shards reached the end of the window
+ * @param shard* The shard of the calling thread
+ * @param time_t End of the window
+ *
+ * */
+static void barrier(shard *sh, time_t end) {
+    network *n = sh->n;
+    unsigned int gen = __atomic_load_n(&n->barrier_gen, __ATOMIC_ACQUIRE);
+    if (__atomic_add_fetch(&n->barrier_count, 1, __ATOMIC_ACQ_REL) == (unsigned int) n->num_shards) {
+        if (n->cl)
+            exchange(sh, end);
+        __atomic_store_n(&n->barrier_count, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&n->barrier_gen, gen + 1, __ATOMIC_RELEASE);
+        return;
+    }
+    while (__atomic_load_n(&n->barrier_gen, __ATOMIC_ACQUIRE) == gen) {
+        drain(sh);
+        sched_yield();
+    }
+}
+
+/**
+ * @brief Orders flights by arrival time, origin and departure order
+ * @param void* First flight
+ * @param void* Second flight
+ * @return Negative, zero or positive, like strcmp()
+ *
+ * */
+static int compare_flights(const void *a, const void *b) {
+    const flight_msg *x = a, *y = b;
+    if (x->when != y->when)
+        return x->when < y->when ? -1 : 1;
+    if (x->src != y->src)
+        return x->src < y->src ? -1 : 1;
+    return x->seq < y->seq ? -1 : (x->seq > y->seq);
+}
+
+/**
+ * @brief Inserts the pending flights, which arrive up to a time, into the simulations of their destinations
+ * @param shard* The shard, which has to be run by the calling thread
+ * @param time_t End of the window about to be simulated
+ *
+ * */
+static void insert_pending(shard *sh, time_t end) {
+    network *n = sh->n;
+    flight_list *l = &sh->pending;
+    qsort(l->items, l->len, sizeof(flight_msg), compare_flights);
+    size_t i = 0;
+    while (i < l->len && l->items[i].when <= end) {
+        sim_add_arrival(n->nodes[l->items[i].dst].s, l->items[i].when, l->items[i].name);
+        ++i;
+    }
+    memmove(l->items, l->items + i, (l->len - i) * sizeof(flight_msg));
+    l->len -= i;
+}
+
+/**
+ * @brief Sends a plane, which took off, to its next airport
+ * @param void* The node of the origin airport
+ * @param sim* Simulation of the origin airport
+ * @param char* Name of the plane
+ *
+ * Called by the simulation of the origin, in the thread of its shard.
+ *
+ * */
+static void on_departure(void *arg, sim *s, const char *name) {
+    node *nd = arg;
+    network *n = nd->n;
+    flight_msg msg;
+    msg.src = nd->id;
+    msg.dst = nd->id == 0 ? 1 + (int) rng_range(n->num_airports - 1) : 0;
+    msg.when = sim_now(s) + n->window + rng_range(n->window);
+    msg.seq = nd->seq++;
+    memset(msg.name, 0, sizeof(msg.name));
+    strncpy(msg.name, name, sizeof(msg.name) - 1);
+
+    shard *sh = &n->shards[shard_of(n, nd->id)];
+    if (msg.dst % n->num_procs != n->proc) {
+        list_add(&sh->remote[msg.dst % n->num_procs], &msg);
+        return;
+    }
+    if (shard_of(n, msg.dst) != sh->id)
+        sh->sent++;
+    route(sh, &msg);
+}
+
+/**
+ * @brief Thread running a shard
+ * @param shard* The shard
+ * @return NULL
+ *
+ * */
+static void *shard_thread_func(shard *sh) {
+    network *n = sh->n;
+    for (time_t start = n->now; start < n->end; start += n->window) {
+        time_t end = start + n->window < n->end ? start + n->window : n->end;
+        insert_pending(sh, end);
+        for (int i = n->proc + sh->id * n->num_procs; i < n->num_airports; i += n->num_procs * n->num_shards) {
+            node *nd = &n->nodes[i];
+            rng_set_state(nd->rng);
+            sim_run(nd->s, end - sim_now(nd->s));
+            rng_get_state(nd->rng);
+        }
+        barrier(sh, end);
+        drain(sh);
+    }
+    return NULL;
+}
+
+network *network_init(const config *cfg, cluster *cl, const arrival *landing, const arrival *takeoff) {
+    network *n = (network *) malloc(sizeof(network));
+    n->num_airports = cfg->num_airports;
+    n->cl = cl;
+    n->proc = cl ? cluster_get_index(cl) : 0;
+    n->num_procs = cl ? cluster_get_size(cl) : 1;
+    int num_local = (n->num_airports - n->proc + n->num_procs - 1) / n->num_procs;
+    n->num_shards = cfg->num_shards > 0 ? cfg->num_shards : (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (n->num_shards > num_local)
+        n->num_shards = num_local;
+    if (n->num_shards < 1)
+        n->num_shards = 1;
+    n->window = cfg->flight_minutes * 60000LL;
+    n->now = n->end = 0;
+    n->barrier_count = n->barrier_gen = 0;
+
+    /* every airport draws from its own stream, whichever thread runs it */
+    uint64_t saved[4];
+    rng_get_state(saved);
+    n->nodes = (node *) calloc(n->num_airports, sizeof(node));
+    for (int i = 0; i < n->num_airports; ++i) {
+        node *nd = &n->nodes[i];
+        char name[32];
+        snprintf(name, sizeof(name), "airport %d", i);
+        nd->n = n;
+        nd->id = i;
+        if (i % n->num_procs != n->proc)
+            continue;
+        nd->ap = airport_init(name, cfg->num_bays, cfg->num_runways);
+        /* the actors of the airport draw their first times from its own generator */
+        rng_thread_init(NETWORK_RNG_STREAM + i);
+        nd->s = sim_init(nd->ap, landing, takeoff, cfg->num_landing, cfg->num_takeoff);
+        if (n->num_airports > 1)
+            sim_set_departure_hook(nd->s, on_departure, nd);
+        rng_get_state(nd->rng);
+    }
+    rng_set_state(saved);
+
+    n->shards = (shard *) calloc(n->num_shards, sizeof(shard));
+    n->rings = (ring **) calloc(n->num_shards * n->num_shards, sizeof(ring *));
+    for (int i = 0; i < n->num_shards; ++i) {
+        n->shards[i].n = n;
+        n->shards[i].id = i;
+        n->shards[i].remote = (flight_list *) calloc(n->num_procs, sizeof(flight_list));
+        for (int j = 0; j < n->num_shards; ++j) {
+            if (i != j)
+                n->rings[i * n->num_shards + j] = ring_init(sizeof(flight_msg), NETWORK_RING_SIZE);
+        }
+    }
+    return n;
+}
+
+void network_run(network *n, time_t duration) {
+    n->end = n->now + duration;
+    for (int i = 0; i < n->num_shards; ++i)
+        pthread_create(&n->shards[i].thread, NULL, (void *(*)(void *)) shard_thread_func, &n->shards[i]);
+    for (int i = 0; i < n->num_shards; ++i)
+        pthread_join(n->shards[i].thread, NULL);
+    n->now = n->end;
+}
+
+int network_get_num_airports(network *n) {
+    return n->num_airports;
+}
+
+int network_get_num_shards(network *n) {
+    return n->num_shards;
+}
+
+airport *network_get_airport(network *n, int i) {
+    return n->nodes[i].ap;
+}
+
+unsigned long network_get_messages(network *n) {
+    unsigned long sent = 0;
+    for (int i = 0; i < n->num_shards; ++i)
+        sent += n->shards[i].sent;
+    return sent;
+}
+
+/**
+ * @brief Describes the airports of this process
+ * @param network* The network
+ * @param char** Receives the description of every airport of this process, has to be freed by caller
+ *
+ * */
+static void describe_airports(network *n, char **texts) {
+    for (int i = n->proc; i < n->num_airports; i += n->num_procs) {
+        strbuf *sb = strbuf_init();
+        char *c = sim_to_string(n->nodes[i].s);
+        strbuf_printf(sb, "Airport %d: %s", i, c);
+        free(c);
+        strbuf_printf(sb, "Airport %d: %lu arrivals from the network landed, %lu diverted\n", i,
+                      sim_get_arrivals(n->nodes[i].s), sim_get_diverted(n->nodes[i].s));
+        texts[i] = strbuf_release(sb);
+    }
+}
+
+/**
+ * @brief Sends the descriptions of the airports and the counters of this process to process 0
+ * @param network* The network
+ *
+ * The message is the number of shards, the flights sent between shards and to other processes, followed by the
+ * number and description of every airport.
+ *
+ * */
+static void send_report(network *n) {
+    char **texts = (char **) calloc(n->num_airports, sizeof(char *));
+    describe_airports(n, texts);
+    size_t size = 4 * WIRE_VARINT_MAX;
+    for (int i = n->proc; i < n->num_airports; i += n->num_procs)
+        size += 2 * WIRE_VARINT_MAX + strlen(texts[i]);
+    uint8_t *buf = malloc(size), *p = buf;
+    unsigned long remote = 0;
+    for (int i = 0; i < n->num_shards; ++i)
+        remote += n->shards[i].sent_remote;
+    p += wire_put_varint(p, n->num_shards);
+    p += wire_put_varint(p, network_get_messages(n));
+    p += wire_put_varint(p, remote);
+    for (int i = n->proc; i < n->num_airports; i += n->num_procs) {
+        size_t len = strlen(texts[i]);
+        p += wire_put_varint(p, i);
+        p += wire_put_varint(p, len);
+        memcpy(p, texts[i], len);
+        p += len;
+        free(texts[i]);
+    }
+    cluster_send(n->cl, 0, buf, p - buf);
+    free(buf);
+    free(texts);
+}
+
+char *network_to_string(network *n) {
+    if (n->proc != 0) {
+        send_report(n);
+        return NULL;
+    }
+    char **texts = (char **) calloc(n->num_airports, sizeof(char *));
+    describe_airports(n, texts);
+    int shards = n->num_shards;
+    unsigned long sent = network_get_messages(n), remote = 0;
+    for (int i = 0; i < n->num_shards; ++i)
+        remote += n->shards[i].sent_remote;
+
+    for (int proc = 1; proc < n->num_procs; ++proc) {
+        size_t len;
+        uint8_t *buf = cluster_recv(n->cl, proc, &len);
+        const uint8_t *p = buf, *stop = buf + len;
+        uint64_t v[3], id, text_len;
+        bool ok = wire_get_varint(&p, stop, &v[0]) && wire_get_varint(&p, stop, &v[1]) &&
+                  wire_get_varint(&p, stop, &v[2]);
+        while (ok && p < stop) {
+            ok = wire_get_varint(&p, stop, &id) && wire_get_varint(&p, stop, &text_len) &&
+                 id < (uint64_t) n->num_airports && texts[id] == NULL && text_len <= (size_t) (stop - p);
+            if (ok) {
+                texts[id] = strndup((const char *) p, text_len);
+                p += text_len;
+            }
+        }
+        if (!ok) {
+            fprintf(stderr, "network: invalid report of process %d\n", proc);
+            exit(EXIT_FAILURE);
+        }
+        shards += v[0];
+        sent += v[1];
+        remote += v[2];
+        free(buf);
+    }
+
+    strbuf *sb = strbuf_init();
+    if (n->num_procs > 1)
+        strbuf_printf(sb, "Network of %d airports on %d shards in %d processes, %lu flights between shards, %lu between "
+                      "processes, flights take %.0f to %.0f minutes\n", n->num_airports, shards, n->num_procs, sent,
+                      remote, n->window / 60000.0, 2 * n->window / 60000.0);
+    else
+        strbuf_printf(sb, "Network of %d airports on %d shards, %lu flights between shards, flights take %.0f to %.0f "
+                      "minutes\n", n->num_airports, shards, sent, n->window / 60000.0, 2 * n->window / 60000.0);
+    for (int i = 0; i < n->num_airports; ++i) {
+        strbuf_printf(sb, "%s", texts[i] ? texts[i] : "");
+        free(texts[i]);
+    }
+    free(texts);
+    return strbuf_release(sb);
+}
+
+void network_destroy(network *n) {
+    for (int i = n->proc; i < n->num_airports; i += n->num_procs) {
+        sim_destroy(n->nodes[i].s);
+        airport_destroy(n->nodes[i].ap);
+    }
+    for (int i = 0; i < n->num_shards * n->num_shards; ++i) {
+        if (n->rings[i])
+            ring_destroy(n->rings[i]);
+    }
+    for (int i = 0; i < n->num_shards; ++i) {
+        free(n->shards[i].pending.items);
+        for (int j = 0; j < n->num_procs; ++j)
+            free(n->shards[i].remote[j].items);
+        free(n->shards[i].remote);
+    }
+    free(n->rings);
+    free(n->shards);
+    free(n->nodes);
+    free(n);
+}
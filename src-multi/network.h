@@ -0,0 +1,123 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file network.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible methods of the airport network simulation.
+ *
+ * The network simulates several airports in virtual time, as a hub and spoke network: airport 0 is the hub, planes
+ * taking off at a spoke fly to the hub, and planes taking off at the hub fly to a random spoke. Each airport has its
+ * own discrete-event simulation.
+ *
+ * The airports are split among shards, each run by one thread. Flights between shards are passed through lock-free
+ * single producer, single consumer rings. The shards advance in windows as long as the shortest flight, so that no
+ * flight can arrive within the window it departed in, and wait for each other only at the end of a window. Arrivals
+ * are inserted in a fixed order and every airport has its own random number generator, so the result depends on the
+ * seed only, not on the number of shards.
+ *
+ * The network can also run in a cluster of processes, airport i in process i % size of the cluster. At the end of a
+ * window, each process sends the flights to the airports of every other process in one batch, in a compact binary
+ * format. The result does not depend on the number of processes either.
+ *
+ */
+
+#ifndef NETWORK_H
+#define NETWORK_H
+
+#include "airport.h"
+#include "arrival.h"
+#include "cluster.h"
+#include "config.h"
+
+/**
+ * @brief Forward declaration for network
+ *
+ * */
+typedef struct network network;
+
+/**
+ * @brief constructor for network
+ * @param config* Settings, every airport gets the configured bays, runways and actors
+ * @param cluster* Processes running the network, or NULL to run all airports in this process
+ * @param arrival* Arrival process of the landing actors of every airport, which must exist as long as the network
+ * @param arrival* Arrival process of the take-off actors of every airport, which must exist as long as the network
+ * @return A pointer to the network structure, representing the created object
+ *
+ * Only the airports of this process are created. All processes of the cluster have to use the same settings.
+ *
+ * After using this structure, it must be freed with network_destroy(network *)
+ *
+ * */
+network *network_init(const config *, cluster *, const arrival *, const arrival *);
+
+/**
+ * @brief Advances all airports
+ * @param network* Pointer to structure to work on
+ * @param time_t Virtual time in milliseconds to simulate
+ *
+ * Starts one thread per shard and returns when all of them have simulated the given time. In a cluster, all processes
+ * have to call it with the same time.
+ *
+ * */
+void network_run(network *, time_t);
+
+/**
+ * @brief Gets the number of airports
+ * @param network* Pointer to structure to work on
+ * @return Number of airports
+ *
+ * */
+int network_get_num_airports(network *);
+
+/**
+ * @brief Gets the number of shards of this process
+ * @param network* Pointer to structure to work on
+ * @return Number of shards, each run by one thread
+ *
+ * */
+int network_get_num_shards(network *);
+
+/**
+ * @brief Gets an airport of the network
+ * @param network* Pointer to structure to work on
+ * @param int Number of the airport, 0 is the hub
+ * @return The airport, which must not be used while the network runs, or NULL if it is run by another process
+ *
+ * */
+airport *network_get_airport(network *, int);
+
+/**
+ * @brief Gets the number of flights, which were passed between shards of this process
+ * @param network* Pointer to structure to work on
+ * @return Number of flights, which crossed shards
+ *
+ * */
+unsigned long network_get_messages(network *);
+
+/**
+ * @brief Method for getting a string representation of the network statistics
+ * @param network* Pointer to structure to work on
+ * @return A pointer to a string with two lines per airport, which must be freed by caller, or NULL in processes other
+ * than process 0
+ *
+ * In a cluster, all processes have to call it: process 0 collects the statistics of the airports of the others.
+ *
+ * */
+char *network_to_string(network *);
+
+/**
+ * @brief Destructor for network
+ * @param network* Pointer to structure to be freed
+ *
+ * All airports and their simulations are freed.
+ *
+ * */
+void network_destroy(network *);
+
+#endif /* NETWORK_H */
@@ -0,0 +1,425 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file scheduler.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods for scheduler class.
+ *
+ * Every worker owns a Chase-Lev deque: the owner pushes and pops at the bottom, thieves take from the top. Tasks
+ * submitted from outside the workers, and tasks whose time has come, go through a shared injection list. A timer
+ * thread keeps scheduled tasks in an event queue and moves them to the injection list when they are due. Workers
+ * without work sleep on a condition variable and are woken by new submissions.
+ *
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "lockstat.h"
+#include "scheduler.h"
+#include "eventqueue.h"
+#include "pool.h"
+#include "timesource.h"
+#include "tools.h"
+
+/**
+* @brief Number of tasks a worker's deque can hold, further tasks go to the injection list
+*
+*/
+#define DEQUE_SIZE 4096
+
+/**
+* @brief Number of tasks preallocated in the task pool
+*
+*/
+#define TASK_POOL_SIZE 1024
+
+/**
+* @brief Size of a cache line in bytes
+*
+*/
+#define CACHE_LINE 64
+
+/**
+* @brief A task waiting to be run
+*
+*/
+typedef struct task {
+    task_fn fn; /**< Function to run. */
+    void *arg; /**< Argument of the function. */
+    struct task *next; /**< Next task in the injection list. */
+} task;
+
+/**
+* @brief Work-stealing deque of a worker
+*
+*/
+typedef struct deque {
+    long top; /**< Next position to steal from, advanced by thieves and by the owner for the last task. */
+    char pad0[CACHE_LINE]; /**< Keeps top and bottom on different cache lines. */
+    long bottom; /**< Next position to push to, only written by the owner. */
+    char pad1[CACHE_LINE]; /**< Keeps bottom away from the next deque. */
+    task *buf[DEQUE_SIZE]; /**< The tasks, indexed by position modulo DEQUE_SIZE. */
+} deque;
+
+/**
+* @brief A worker thread and its deque
+*
+*/
+typedef struct worker {
+    scheduler *s; /**< The scheduler the worker belongs to. */
+    pthread_t thread; /**< The worker thread. */
+    unsigned int id; /**< Index of the worker. */
+    deque dq; /**< Tasks of the worker. */
+} worker;
+
+/**
+* @brief Scheduler structure for representing an instance of a scheduler
+*
+*/
+struct scheduler {
+    worker **workers; /**< All workers. */
+    int num_workers; /**< Length of workers. */
+    pool *tasks; /**< Pool the tasks are taken from. */
+    lockstat inject_lock; /**< Protects the injection list. */
+    task *inject_head; /**< Oldest task in the injection list. */
+    task *inject_tail; /**< Newest task in the injection list. */
+    pthread_mutex_t idle_lock; /**< Protects sleeping on idle_cv. */
+    pthread_cond_t idle_cv; /**< Signalled when new work arrives. */
+    int idle; /**< Number of workers about to sleep or sleeping. */
+    unsigned long epoch; /**< Incremented with every submission, so that workers do not sleep through it. */
+    pthread_mutex_t timer_lock; /**< Protects timers. */
+    pthread_cond_t timer_cv; /**< Signalled when an earlier timer is added or the scheduler stops. */
+    eventqueue *timers; /**< Scheduled tasks, keyed on the time they become runnable. */
+    pthread_t timer_thread; /**< Thread moving due timers to the injection list. */
+    bool stopping; /**< Set when the scheduler is destroyed. */
+};
+
+/**
+* @brief Worker the current thread belongs to, NULL outside of workers
+*
+*/
+static __thread worker *current_worker = NULL;
+
+/**
+* @brief Pushes a task to the bottom of a deque
+* @param deque* The deque, owned by the calling thread
+* @param task* The task
+* @return False, if the deque is full
+*
+* */
+static bool deque_push(deque *d, task *t) {
+    long b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+    long top = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    if (b - top >= DEQUE_SIZE)
+        return false;
+    __atomic_store_n(&d->buf[b % DEQUE_SIZE], t, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+/**
+* @brief Pops a task from the bottom of a deque
+* @param deque* The deque, owned by the calling thread
+* @return The newest task, or NULL if the deque is empty
+*
+* */
+static task *deque_pop(deque *d) {
+    long b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&d->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long top = __atomic_load_n(&d->top, __ATOMIC_RELAXED);
+    if (top > b) {
+        /* empty */
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    task *t = __atomic_load_n(&d->buf[b % DEQUE_SIZE], __ATOMIC_RELAXED);
+    if (top == b) {
+        /* the last task, race against thieves for it */
+        if (!__atomic_compare_exchange_n(&d->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+            t = NULL;
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+    return t;
+}
+
+/**
+* @brief Steals a task from the top of a deque
+* @param deque* The deque of another worker
+* @return The oldest task, or NULL if the deque is empty or another thread was faster
+*
+* */
+static task *deque_steal(deque *d) {
+    long top = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long b = __atomic_load_n(&d->bottom, __ATOMIC_ACQUIRE);
+    if (top >= b)
+        return NULL;
+    task *t = __atomic_load_n(&d->buf[top % DEQUE_SIZE], __ATOMIC_RELAXED);
+    if (!__atomic_compare_exchange_n(&d->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        return NULL;
+    return t;
+}
+
+/**
+* @brief Wakes a sleeping worker, if there is one
+* @param scheduler* Pointer to structure to work on
+*
+* */
+static void notify(scheduler *s) {
+    __atomic_add_fetch(&s->epoch, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&s->idle, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&s->idle_lock);
+        pthread_cond_signal(&s->idle_cv);
+        pthread_mutex_unlock(&s->idle_lock);
+    }
+}
+
+/**
+* @brief Appends tasks to the injection list
+* @param scheduler* Pointer to structure to work on
+* @param task* First task of a linked list of tasks
+* @param task* Last task of the list
+*
+* */
+static void inject(scheduler *s, task *first, task *last) {
+    last->next = NULL;
+    lockstat_lock(&s->inject_lock);
+    if (s->inject_tail)
+        s->inject_tail->next = first;
+    else
+        __atomic_store_n(&s->inject_head, first, __ATOMIC_RELAXED);
+    s->inject_tail = last;
+    lockstat_unlock(&s->inject_lock);
+    notify(s);
+}
+
+/**
+* @brief Takes the oldest task from the injection list
+* @param scheduler* Pointer to structure to work on
+* @return The task, or NULL if the list is empty
+*
+* */
+static task *take_injected(scheduler *s) {
+    if (__atomic_load_n(&s->inject_head, __ATOMIC_RELAXED) == NULL)
+        return NULL;
+    lockstat_lock(&s->inject_lock);
+    task *t = s->inject_head;
+    if (t) {
+        __atomic_store_n(&s->inject_head, t->next, __ATOMIC_RELAXED);
+        if (s->inject_head == NULL)
+            s->inject_tail = NULL;
+    }
+    lockstat_unlock(&s->inject_lock);
+    return t;
+}
+
+/**
+* @brief Finds a task for a worker
+* @param worker* The worker
+* @return A task, or NULL if there is no work anywhere
+*
+* The worker's own deque comes first, then the injection list, then the deques of the other workers, starting at a
+* random one.
+*
+* */
+static task *find_task(worker *w) {
+    scheduler *s = w->s;
+    task *t = deque_pop(&w->dq);
+    if (t)
+        return t;
+    t = take_injected(s);
+    if (t)
+        return t;
+    int start = rng_range(s->num_workers);
+    for (int i = 0; i < s->num_workers; ++i) {
+        worker *victim = s->workers[(start + i) % s->num_workers];
+        if (victim != w && (t = deque_steal(&victim->dq)) != NULL)
+            return t;
+    }
+    return NULL;
+}
+
+/**
+* @brief Runs a task and gives it back to the pool
+* @param scheduler* Pointer to structure to work on
+* @param task* The task
+*
+* */
+static void run_task(scheduler *s, task *t) {
+    task_fn fn = t->fn;
+    void *arg = t->arg;
+    pool_free(s->tasks, t);
+    fn(arg);
+}
+
+/**
+* @brief Worker thread
+* @param worker* The worker
+*
+* Runs tasks until the scheduler is stopped, and sleeps while there is no work.
+*
+* */
+static void *worker_thread_func(worker *w) {
+    scheduler *s = w->s;
+    current_worker = w;
+    rng_thread_init((1u << 16) + w->id);
+    while (!__atomic_load_n(&s->stopping, __ATOMIC_ACQUIRE)) {
+        unsigned long seen = __atomic_load_n(&s->epoch, __ATOMIC_SEQ_CST);
+        task *t = find_task(w);
+        if (t) {
+            run_task(s, t);
+            continue;
+        }
+        /* announce sleeping before checking for submissions made during the search */
+        __atomic_add_fetch(&s->idle, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_lock(&s->idle_lock);
+        if (__atomic_load_n(&s->epoch, __ATOMIC_SEQ_CST) == seen && !__atomic_load_n(&s->stopping, __ATOMIC_ACQUIRE))
+            pthread_cond_wait(&s->idle_cv, &s->idle_lock);
+        pthread_mutex_unlock(&s->idle_lock);
+        __atomic_sub_fetch(&s->idle, 1, __ATOMIC_SEQ_CST);
+    }
+    return NULL;
+}
+
+/**
+* @brief Timer thread
+* @param scheduler* Pointer to structure to work on
+*
+* Moves scheduled tasks to the injection list when they are due.
+*
+* */
+static void *timer_thread_func(scheduler *s) {
+    pthread_mutex_lock(&s->timer_lock);
+    while (!__atomic_load_n(&s->stopping, __ATOMIC_ACQUIRE)) {
+        time_t next = eventqueue_peek_time(s->timers);
+        if (next < 0) {
+            pthread_cond_wait(&s->timer_cv, &s->timer_lock);
+            continue;
+        }
+        time_t now = current_timestamp();
+        if (next > now) {
+            struct timespec ts;
+            timesource_deadline(&ts, next - now);
+            pthread_cond_timedwait(&s->timer_cv, &s->timer_lock, &ts);
+            continue;
+        }
+        /* collect all due tasks and inject them at once */
+        task *first = NULL, *last = NULL;
+        event e;
+        while (eventqueue_size(s->timers) > 0 && eventqueue_peek_time(s->timers) <= now) {
+            eventqueue_pop(s->timers, &e);
+            task *t = e.data;
+            t->next = NULL;
+            if (last)
+                last->next = t;
+            else
+                first = t;
+            last = t;
+        }
+        pthread_mutex_unlock(&s->timer_lock);
+        inject(s, first, last);
+        pthread_mutex_lock(&s->timer_lock);
+    }
+    pthread_mutex_unlock(&s->timer_lock);
+    return NULL;
+}
+
+scheduler *scheduler_init(int num_workers) {
+    scheduler *s = (scheduler *) malloc(sizeof(scheduler));
+    if (num_workers <= 0)
+        num_workers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_workers <= 0)
+        num_workers = 1;
+    s->num_workers = num_workers;
+    s->tasks = pool_init(sizeof(task), TASK_POOL_SIZE);
+    lockstat_init(&s->inject_lock, "scheduler_inject");
+    s->inject_head = s->inject_tail = NULL;
+    pthread_mutex_init(&s->idle_lock, NULL);
+    pthread_cond_init(&s->idle_cv, NULL);
+    s->idle = 0;
+    s->epoch = 0;
+    pthread_mutex_init(&s->timer_lock, NULL);
+    timesource_cond_init(&s->timer_cv);
+    s->timers = eventqueue_init();
+    s->stopping = false;
+
+    s->workers = (worker **) malloc(num_workers * sizeof(worker *));
+    for (int i = 0; i < num_workers; ++i) {
+        worker *w = (worker *) malloc(sizeof(worker));
+        w->s = s;
+        w->id = i;
+        w->dq.top = 0;
+        w->dq.bottom = 0;
+        s->workers[i] = w;
+    }
+    for (int i = 0; i < num_workers; ++i)
+        pthread_create(&s->workers[i]->thread, NULL, (void *(*)(void *)) worker_thread_func, s->workers[i]);
+    pthread_create(&s->timer_thread, NULL, (void *(*)(void *)) timer_thread_func, s);
+    return s;
+}
+
+int scheduler_get_num_workers(scheduler *s) {
+    return s->num_workers;
+}
+
+void scheduler_submit(scheduler *s, task_fn fn, void *arg) {
+    task *t = (task *) pool_alloc(s->tasks);
+    t->fn = fn;
+    t->arg = arg;
+    worker *w = current_worker;
+    if (w != NULL && w->s == s && deque_push(&w->dq, t)) {
+        notify(s);
+        return;
+    }
+    inject(s, t, t);
+}
+
+void scheduler_submit_at(scheduler *s, time_t when, task_fn fn, void *arg) {
+    task *t = (task *) pool_alloc(s->tasks);
+    t->fn = fn;
+    t->arg = arg;
+    pthread_mutex_lock(&s->timer_lock);
+    time_t next = eventqueue_peek_time(s->timers);
+    eventqueue_push(s->timers, when, 0, 0, t);
+    /* the timer thread only has to wake up, if this is the new earliest timer */
+    if (next < 0 || when < next)
+        pthread_cond_signal(&s->timer_cv);
+    pthread_mutex_unlock(&s->timer_lock);
+}
+
+void scheduler_destroy(scheduler *s) {
+    __atomic_store_n(&s->stopping, true, __ATOMIC_RELEASE);
+    pthread_mutex_lock(&s->idle_lock);
+    pthread_cond_broadcast(&s->idle_cv);
+    pthread_mutex_unlock(&s->idle_lock);
+    pthread_mutex_lock(&s->timer_lock);
+    pthread_cond_signal(&s->timer_cv);
+    pthread_mutex_unlock(&s->timer_lock);
+
+    for (int i = 0; i < s->num_workers; ++i) {
+        pthread_join(s->workers[i]->thread, NULL);
+        free(s->workers[i]);
+    }
+    pthread_join(s->timer_thread, NULL);
+    free(s->workers);
+
+    /* pending tasks are freed together with their pool */
+    eventqueue_destroy(s->timers);
+    pool_destroy(s->tasks);
+    lockstat_destroy(&s->inject_lock);
+    pthread_mutex_destroy(&s->idle_lock);
+    pthread_cond_destroy(&s->idle_cv);
+    pthread_mutex_destroy(&s->timer_lock);
+    pthread_cond_destroy(&s->timer_cv);
+    free(s);
+}
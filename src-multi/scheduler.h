@@ -0,0 +1,88 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file scheduler.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible scheduler methods.
+ *
+ * The scheduler runs small tasks on a fixed pool of worker threads. Every worker has its own work-stealing deque;
+ * tasks submitted by a worker go to its own deque, and idle workers steal from the others. Tasks can also be scheduled
+ * for a point in time, so that waiting costs a timer entry instead of a sleeping thread.
+ *
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <time.h>
+
+/**
+ * @brief Function executed by a task
+ *
+ * */
+typedef void (*task_fn)(void *);
+
+/**
+ * @brief Forward declaration for scheduler
+ *
+ * */
+typedef struct scheduler scheduler;
+
+/**
+ * @brief constructor for scheduler
+ * @param int Number of worker threads, or 0 to use one per online processor
+ * @return A pointer to the scheduler structure, representing the created object
+ *
+ * The workers are started right away.
+ * After using this structure, it must be freed with scheduler_destroy(scheduler *)
+ *
+ * */
+scheduler *scheduler_init(int);
+
+/**
+ * @brief Gets the number of worker threads
+ * @param scheduler* Pointer to structure to work on
+ * @return The number of worker threads
+ *
+ * */
+int scheduler_get_num_workers(scheduler *);
+
+/**
+ * @brief Submits a task for immediate execution
+ * @param scheduler* Pointer to structure to work on
+ * @param task_fn Function to run
+ * @param void* Argument passed to the function
+ *
+ * It is thread safe and does not block, unless it is called from outside the workers.
+ *
+ * */
+void scheduler_submit(scheduler *, task_fn, void *);
+
+/**
+ * @brief Submits a task for execution at a given time
+ * @param scheduler* Pointer to structure to work on
+ * @param time_t Time in milliseconds as returned by current_timestamp(), at which the task becomes runnable
+ * @param task_fn Function to run
+ * @param void* Argument passed to the function
+ *
+ * It is thread safe.
+ *
+ * */
+void scheduler_submit_at(scheduler *, time_t, task_fn, void *);
+
+/**
+ * @brief Destructor for scheduler
+ * @param scheduler* Pointer to structure to be freed
+ *
+ * Running tasks are finished, pending and scheduled tasks are dropped without being run.
+ *
+ * */
+void scheduler_destroy(scheduler *);
+
+#endif /* SCHEDULER_H */
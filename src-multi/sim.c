@@ -0,0 +1,560 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file sim.c
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief File containing public methods for the discrete-event simulation.
+ *
+ * Each actor mirrors one landing or take-off thread of the threaded simulation: it wakes up as its arrival process
+ * says, e.g. every 500ms to decide with the given probability whether to start an operation, waits up to 5 seconds for
+ * a bay (or parked plane) and a runway, and occupies the runway for 2 seconds. Waiting actors are queued in FIFO order
+ * and woken as soon as the resource they wait for is given back.
+ *
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "sim.h"
+#include "eventqueue.h"
+#include "logger.h"
+#include "stats.h"
+#include "tools.h"
+
+/**
+* @brief Time a plane occupies the runway for landing or take-off in milliseconds
+*
+*/
+#define SIM_RUNWAY_MS 2000
+
+/**
+* @brief Maximum time an operation waits for a bay, plane or runway in milliseconds
+*
+*/
+#define SIM_TIMEOUT_MS 5000
+
+/**
+* @brief Types of the events in the simulation
+*
+*/
+enum {
+    EV_TICK, /**< The actor wakes up and decides whether to start an operation. */
+    EV_TIMEOUT, /**< The deadline of the actor's operation has passed. */
+    EV_RUNWAY_DONE, /**< The actor's plane has finished landing or taking off. */
+    EV_ARRIVAL /**< A plane from elsewhere arrives. */
+};
+
+/**
+* @brief States of an actor
+*
+*/
+enum {
+    ACTOR_IDLE, /**< The actor waits until it wakes up next. */
+    ACTOR_WAIT_BAY, /**< The landing actor waits for a free bay. */
+    ACTOR_WAIT_PLANE, /**< The take-off actor waits for a parked plane. */
+    ACTOR_WAIT_RUNWAY, /**< The actor waits for a free runway. */
+    ACTOR_ON_RUNWAY /**< The actor's plane is landing or taking off. */
+};
+
+/**
+* @brief Actor structure for representing a landing or take-off thread
+*
+*/
+typedef struct actor {
+    bool landing; /**< True for landing actors, false for take-off actors. */
+    bool arrival; /**< True for a plane from sim_add_arrival(), which does only one landing. */
+    char name[8]; /**< Name of the arriving plane. */
+    const arrival *process; /**< Arrival process deciding when the actor operates, NULL for arrivals. */
+    int state; /**< Current state of the actor. */
+    unsigned int gen; /**< Incremented for every operation, so that timeouts of finished operations are ignored. */
+    plane *plane; /**< Plane which is landing or taking off, NULL if there is none. */
+    int bay_nr; /**< Bay reserved by the current operation. */
+    int runway; /**< Runway used by the current operation. */
+    time_t wait_start; /**< Time the actor started waiting for its current resource. */
+    time_t wake_at; /**< Time the actor was due to wake up last, which its next wake up is counted from. */
+    struct actor *prev; /**< Previous actor in the wait list. */
+    struct actor *next; /**< Next actor in the wait list, or next spare arrival. */
+    struct actor *all_next; /**< Next of all arrival actors. */
+} actor;
+
+/**
+* @brief FIFO list of actors waiting for the same resource
+*
+*/
+typedef struct waitlist {
+    actor *head; /**< Actor waiting longest. */
+    actor *tail; /**< Actor waiting shortest. */
+} waitlist;
+
+/**
+* @brief Sim structure for representing an instance of a discrete-event simulation
+*
+*/
+struct sim {
+    airport *ap; /**< The simulated airport. */
+    eventqueue *events; /**< Pending events. */
+    time_t now; /**< Current virtual time in milliseconds. */
+    actor *actors; /**< All landing and take-off actors. */
+    int num_actors; /**< Length of actors. */
+    waitlist bay_waiters; /**< Landing actors waiting for a free bay. */
+    waitlist plane_waiters; /**< Take-off actors waiting for a parked plane. */
+    waitlist runway_waiters; /**< Actors waiting for a free runway. */
+    unsigned long landings; /**< Number of finished landings. */
+    unsigned long takeoffs; /**< Number of finished take-offs. */
+    unsigned long timeouts; /**< Number of operations given up after the timeout. */
+    unsigned long num_events; /**< Number of processed events. */
+    unsigned long arrivals; /**< Number of arrivals, which landed. */
+    unsigned long diverted; /**< Number of arrivals, which gave up. */
+    actor *arrival_actors; /**< All actors ever created for arrivals, linked by all_next. */
+    actor *spare; /**< Arrival actors, which are done and can be reused, linked by next. */
+    sim_departure_fn departure_fn; /**< Called for planes, which finished taking off, or NULL. */
+    void *departure_arg; /**< Argument of departure_fn. */
+};
+
+/**
+* @brief Simulation, whose virtual time is returned by current_timestamp() in this thread
+*
+*/
+static __thread sim *active_sim = NULL;
+
+static void try_bay(sim *s, actor *a);
+static void try_plane(sim *s, actor *a);
+static void try_runway(sim *s, actor *a);
+
+/**
+* @brief Timestamp source for current_timestamp() while a simulation is active
+* @return The virtual time of the active simulation
+*
+* */
+static time_t sim_timestamp(void) {
+    return active_sim->now;
+}
+
+/**
+* @brief Appends an actor to a wait list
+* @param waitlist* The list to append to
+* @param actor* The actor to append
+*
+* */
+static void waitlist_push(waitlist *l, actor *a) {
+    a->next = NULL;
+    a->prev = l->tail;
+    if (l->tail)
+        l->tail->next = a;
+    else
+        l->head = a;
+    l->tail = a;
+}
+
+/**
+* @brief Removes an actor from a wait list
+* @param waitlist* The list to remove from
+* @param actor* The actor to remove, which must be in the list
+*
+* */
+static void waitlist_remove(waitlist *l, actor *a) {
+    if (a->prev)
+        a->prev->next = a->next;
+    else
+        l->head = a->next;
+    if (a->next)
+        a->next->prev = a->prev;
+    else
+        l->tail = a->prev;
+    a->prev = a->next = NULL;
+}
+
+/**
+* @brief Removes and returns the actor waiting longest
+* @param waitlist* The list to pop from
+* @return The actor, or NULL if nobody is waiting
+*
+* */
+static actor *waitlist_pop(waitlist *l) {
+    actor *a = l->head;
+    if (a)
+        waitlist_remove(l, a);
+    return a;
+}
+
+/**
+* @brief Schedules the next time an actor wakes up
+* @param sim* The simulation
+* @param actor* The actor
+*
+* The time the actor is due may have passed while it was busy, it then wakes up at once. It is still counted from the
+* time it was due, so that the busy time does not lower the rate of its arrival process.
+*
+* */
+static void schedule_wake_up(sim *s, actor *a) {
+    a->wake_at = arrival_next_at(a->process, a->wake_at, s->now);
+    eventqueue_push(s->events, a->wake_at > s->now ? a->wake_at : s->now, EV_TICK, a->gen, a);
+}
+
+/**
+* @brief Finishes the current operation of an actor and schedules the next time it wakes up
+* @param sim* The simulation
+* @param actor* The actor
+*
+* */
+static void finish_operation(sim *s, actor *a) {
+    a->state = ACTOR_IDLE;
+    a->plane = NULL;
+    if (a->arrival) {
+        /* pending timeouts of the actor are ignored, because its generation changes before it is reused */
+        a->next = s->spare;
+        s->spare = a;
+        return;
+    }
+    schedule_wake_up(s, a);
+}
+
+/**
+* @brief Wakes the landing actor waiting longest for a bay
+* @param sim* The simulation
+*
+* */
+static void wake_bay_waiter(sim *s) {
+    actor *a = waitlist_pop(&s->bay_waiters);
+    if (a)
+        try_bay(s, a);
+}
+
+/**
+* @brief Wakes the take-off actor waiting longest for a plane
+* @param sim* The simulation
+*
+* */
+static void wake_plane_waiter(sim *s) {
+    actor *a = waitlist_pop(&s->plane_waiters);
+    if (a)
+        try_plane(s, a);
+}
+
+/**
+* @brief Wakes the actor waiting longest for a runway
+* @param sim* The simulation
+*
+* */
+static void wake_runway_waiter(sim *s) {
+    actor *a = waitlist_pop(&s->runway_waiters);
+    if (a)
+        try_runway(s, a);
+}
+
+/**
+* @brief Lets a landing actor reserve a bay, or queues it if the airport is full
+* @param sim* The simulation
+* @param actor* The landing actor
+*
+* */
+static void try_bay(sim *s, actor *a) {
+    int bay_nr = airport_reserve_bay(s->ap);
+    if (bay_nr < 0) {
+        a->state = ACTOR_WAIT_BAY;
+        waitlist_push(&s->bay_waiters, a);
+        return;
+    }
+    a->bay_nr = bay_nr;
+    a->plane = a->arrival ? plane_init_named(a->name) : plane_init();
+    stats_record(STATS_BAY_WAIT, s->now - a->wait_start);
+    a->wait_start = s->now;
+    try_runway(s, a);
+}
+
+/**
+* @brief Lets a take-off actor claim a parked plane, or queues it if the airport is empty
+* @param sim* The simulation
+* @param actor* The take-off actor
+*
+* */
+static void try_plane(sim *s, actor *a) {
+    if (!airport_claim_plane(s->ap)) {
+        a->state = ACTOR_WAIT_PLANE;
+        waitlist_push(&s->plane_waiters, a);
+        return;
+    }
+    stats_record(STATS_PLANE_WAIT, s->now - a->wait_start);
+    a->wait_start = s->now;
+    try_runway(s, a);
+}
+
+/**
+* @brief Lets an actor acquire a runway, or queues it if all runways are in use
+* @param sim* The simulation
+* @param actor* The actor
+*
+* On success, the landing or take-off starts and finishes after SIM_RUNWAY_MS.
+*
+* */
+static void try_runway(sim *s, actor *a) {
+    int rw = airport_acquire_runway(s->ap);
+    if (rw < 0) {
+        a->state = ACTOR_WAIT_RUNWAY;
+        waitlist_push(&s->runway_waiters, a);
+        return;
+    }
+    a->runway = rw;
+    a->state = ACTOR_ON_RUNWAY;
+    stats_record(STATS_RUNWAY_WAIT, s->now - a->wait_start);
+    if (a->landing) {
+        logger_event(LOGGER_LANDING, plane_get_name(a->plane), a->bay_nr, rw, 0);
+    } else {
+        a->plane = airport_unpark_plane(s->ap, &a->bay_nr);
+        if (logger_enabled(LOGGER_TAKEOFF))
+            logger_event(LOGGER_TAKEOFF, plane_get_name(a->plane), a->bay_nr, rw, airport_get_bay_time(s->ap, a->bay_nr));
+    }
+    eventqueue_push(s->events, s->now + SIM_RUNWAY_MS, EV_RUNWAY_DONE, a->gen, a);
+}
+
+/**
+* @brief Handles the tick of an actor
+* @param sim* The simulation
+* @param actor* The actor
+*
+* */
+static void on_tick(sim *s, actor *a) {
+    if (!arrival_fires(a->process)) {
+        schedule_wake_up(s, a);
+        return;
+    }
+    a->gen++;
+    a->wait_start = s->now;
+    eventqueue_push(s->events, s->now + SIM_TIMEOUT_MS, EV_TIMEOUT, a->gen, a);
+    if (a->landing)
+        try_bay(s, a);
+    else
+        try_plane(s, a);
+}
+
+/**
+* @brief Handles the arrival of a plane from elsewhere
+* @param sim* The simulation
+* @param actor* The arrival actor
+*
+* */
+static void on_arrival(sim *s, actor *a) {
+    a->wait_start = s->now;
+    eventqueue_push(s->events, s->now + SIM_TIMEOUT_MS, EV_TIMEOUT, a->gen, a);
+    try_bay(s, a);
+}
+
+/**
+* @brief Handles the deadline of an actor's operation
+* @param sim* The simulation
+* @param actor* The actor
+*
+* The operation is given up, if the actor is still waiting. Resources it already holds are given back.
+*
+* */
+static void on_timeout(sim *s, actor *a) {
+    switch (a->state) {
+        case ACTOR_WAIT_BAY:
+            waitlist_remove(&s->bay_waiters, a);
+            break;
+        case ACTOR_WAIT_PLANE:
+            waitlist_remove(&s->plane_waiters, a);
+            break;
+        case ACTOR_WAIT_RUNWAY:
+            waitlist_remove(&s->runway_waiters, a);
+            if (a->landing) {
+                /* the plane is turned away and the bay is free again */
+                logger_event(LOGGER_TURNED_AWAY, plane_get_name(a->plane), a->bay_nr, -1, 0);
+                plane_destroy(a->plane);
+                airport_release_bay(s->ap, a->bay_nr);
+                wake_bay_waiter(s);
+            } else {
+                /* the plane stays in its bay */
+                logger_event(LOGGER_STAYED, NULL, -1, -1, 0);
+                airport_unclaim_plane(s->ap);
+                wake_plane_waiter(s);
+            }
+            break;
+        default:
+            /* the operation is not waiting anymore */
+            return;
+    }
+    s->timeouts++;
+    if (a->arrival)
+        s->diverted++;
+    stats_count(STATS_TIMEOUTS);
+    finish_operation(s, a);
+}
+
+/**
+* @brief Handles the end of a landing or take-off
+* @param sim* The simulation
+* @param actor* The actor
+*
+* */
+static void on_runway_done(sim *s, actor *a) {
+    airport_release_runway(s->ap, a->runway);
+    wake_runway_waiter(s);
+    if (a->landing) {
+        airport_park_plane(s->ap, a->bay_nr, a->plane, a->runway);
+        logger_event(LOGGER_PARKED, plane_get_name(a->plane), a->bay_nr, a->runway, 0);
+        s->landings++;
+        if (a->arrival)
+            s->arrivals++;
+        stats_count(STATS_LANDINGS);
+        wake_plane_waiter(s);
+    } else {
+        logger_event(LOGGER_DEPARTED, plane_get_name(a->plane), a->bay_nr, a->runway, 0);
+        if (s->departure_fn)
+            s->departure_fn(s->departure_arg, s, plane_get_name(a->plane));
+        plane_destroy(a->plane);
+        airport_release_bay(s->ap, a->bay_nr);
+        s->takeoffs++;
+        stats_count(STATS_TAKEOFFS);
+        wake_bay_waiter(s);
+    }
+    finish_operation(s, a);
+}
+
+sim *sim_init(airport *ap, const arrival *landing, const arrival *takeoff, int num_landing, int num_takeoff) {
+    sim *s = (sim *) malloc(sizeof(sim));
+    s->ap = ap;
+    s->events = eventqueue_init();
+    s->now = 0;
+    s->landings = s->takeoffs = s->timeouts = s->num_events = 0;
+    s->arrivals = s->diverted = 0;
+    s->arrival_actors = s->spare = NULL;
+    s->departure_fn = NULL;
+    s->departure_arg = NULL;
+    s->bay_waiters.head = s->bay_waiters.tail = NULL;
+    s->plane_waiters.head = s->plane_waiters.tail = NULL;
+    s->runway_waiters.head = s->runway_waiters.tail = NULL;
+
+    s->num_actors = num_landing + num_takeoff;
+    s->actors = (actor *) calloc(s->num_actors, sizeof(actor));
+    for (int i = 0; i < s->num_actors; ++i) {
+        actor *a = &s->actors[i];
+        a->landing = i < num_landing;
+        a->process = a->landing ? landing : takeoff;
+        a->state = ACTOR_IDLE;
+        a->wake_at = arrival_first(a->process);
+        eventqueue_push(s->events, a->wake_at, EV_TICK, a->gen, a);
+    }
+
+    /* bays measure their occupation in virtual time */
+    active_sim = s;
+    set_timestamp_source(sim_timestamp);
+    return s;
+}
+
+void sim_run(sim *s, time_t duration) {
+    time_t end = s->now + duration;
+    event e;
+    /* the simulation may run in another thread than it was created in, or alternate with other simulations */
+    active_sim = s;
+    set_timestamp_source(sim_timestamp);
+    while (eventqueue_size(s->events) > 0 && eventqueue_peek_time(s->events) <= end) {
+        eventqueue_pop(s->events, &e);
+        /* events are only ever scheduled for now or later */
+        assert(e.time >= s->now);
+        s->now = e.time;
+        s->num_events++;
+        switch (e.type) {
+            case EV_TICK:
+                on_tick(s, e.data);
+                break;
+            case EV_TIMEOUT:
+                if (((actor *) e.data)->gen == e.gen)
+                    on_timeout(s, e.data);
+                break;
+            case EV_RUNWAY_DONE:
+                on_runway_done(s, e.data);
+                break;
+            case EV_ARRIVAL:
+                on_arrival(s, e.data);
+                break;
+        }
+    }
+    s->now = end;
+}
+
+void sim_set_departure_hook(sim *s, sim_departure_fn fn, void *arg) {
+    s->departure_fn = fn;
+    s->departure_arg = arg;
+}
+
+void sim_add_arrival(sim *s, time_t when, const char *name) {
+    actor *a = s->spare;
+    if (a) {
+        s->spare = a->next;
+    } else {
+        a = (actor *) calloc(1, sizeof(actor));
+        a->landing = true;
+        a->arrival = true;
+        a->all_next = s->arrival_actors;
+        s->arrival_actors = a;
+    }
+    strncpy(a->name, name, sizeof(a->name) - 1);
+    a->name[sizeof(a->name) - 1] = 0;
+    a->state = ACTOR_IDLE;
+    a->gen++;
+    eventqueue_push(s->events, when, EV_ARRIVAL, a->gen, a);
+}
+
+unsigned long sim_get_arrivals(sim *s) {
+    return s->arrivals;
+}
+
+unsigned long sim_get_diverted(sim *s) {
+    return s->diverted;
+}
+
+void sim_set_time(sim *s, time_t now) {
+    time_t delta = now - s->now;
+    size_t n = eventqueue_size(s->events);
+    event *pending = (event *) malloc((n ? n : 1) * sizeof(event));
+    /* popped in order and pushed again in the same order, so ties keep their order */
+    for (size_t i = 0; i < n; ++i)
+        eventqueue_pop(s->events, &pending[i]);
+    for (size_t i = 0; i < n; ++i)
+        eventqueue_push(s->events, pending[i].time + delta, pending[i].type, pending[i].gen, pending[i].data);
+    free(pending);
+    for (int i = 0; i < s->num_actors; ++i)
+        s->actors[i].wake_at += delta;
+    s->now = now;
+}
+
+time_t sim_now(sim *s) {
+    return s->now;
+}
+
+char *sim_to_string(sim *s) {
+    char *c = malloc(256);
+    snprintf(c, 256, "Simulated %.2f hours: %lu landings, %lu take-offs, %lu timeouts, %lu events\n",
+             s->now / 3600000.0, s->landings, s->takeoffs, s->timeouts, s->num_events);
+    return c;
+}
+
+void sim_destroy(sim *s) {
+    /* planes on a runway are neither parked nor destroyed yet */
+    for (int i = 0; i < s->num_actors; ++i) {
+        if (s->actors[i].state == ACTOR_ON_RUNWAY || (s->actors[i].state == ACTOR_WAIT_RUNWAY && s->actors[i].landing))
+            plane_destroy(s->actors[i].plane);
+    }
+    while (s->arrival_actors) {
+        actor *a = s->arrival_actors;
+        s->arrival_actors = a->all_next;
+        if (a->state == ACTOR_ON_RUNWAY || a->state == ACTOR_WAIT_RUNWAY)
+            plane_destroy(a->plane);
+        free(a);
+    }
+    if (active_sim == s) {
+        active_sim = NULL;
+        set_timestamp_source(NULL);
+    }
+    eventqueue_destroy(s->events);
+    free(s->actors);
+    free(s);
+}
@@ -0,0 +1,145 @@
+/****************************************************************************
+ * Copyright (C) 2014 by Lukas Elsner                                       *
+ *                                                                          *
+ * This file is part of airport-sim.                                        *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file sim.h
+ * @author Lukas Elsner
+ * @date 17-10-2026
+ * @brief Header containing the public accessible methods of the discrete-event simulation.
+ *
+ * The discrete-event simulation drives the same airport as the threaded simulation, but in virtual time. Every
+ * landing and take-off thread is modelled as an actor, which reacts to events from an event queue. Waiting for bays,
+ * planes and runways, as well as the runway occupation, costs no real time, so days of traffic can be simulated in
+ * seconds.
+ *
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <time.h>
+#include "airport.h"
+#include "arrival.h"
+
+/**
+ * @brief Forward declaration for sim
+ *
+ * */
+typedef struct sim sim;
+
+/**
+ * @brief Callback for planes, which finished taking off
+ * @param void* Argument given to sim_set_departure_hook()
+ * @param sim* The simulation
+ * @param char* Name of the plane, valid during the call only
+ *
+ * */
+typedef void (*sim_departure_fn)(void *, sim *, const char *);
+
+/**
+ * @brief constructor for sim
+ * @param airport* The airport to simulate, which must not be used by other threads while the simulation exists
+ * @param arrival* Arrival process of the landing actors, which must exist as long as the simulation
+ * @param arrival* Arrival process of the take-off actors, which must exist as long as the simulation
+ * @param int Number of landing actors
+ * @param int Number of take-off actors
+ * @return A pointer to the sim structure, representing the created object
+ *
+ * While the simulation exists, current_timestamp() returns the virtual time in the calling thread, so logged events
+ * carry virtual timestamps. sim_run() does the same for the thread it runs in.
+ * After using this structure, it must be freed with sim_destroy(sim *)
+ *
+ * */
+sim *sim_init(airport *, const arrival *, const arrival *, int, int);
+
+/**
+ * @brief Advances the simulation
+ * @param sim* Pointer to structure to work on
+ * @param time_t Virtual time in milliseconds to simulate
+ *
+ * All events up to the current virtual time plus the given duration are processed.
+ *
+ * */
+void sim_run(sim *, time_t);
+
+/**
+ * @brief Sets the callback for planes, which finished taking off
+ * @param sim* Pointer to structure to work on
+ * @param sim_departure_fn The callback, or NULL
+ * @param void* Argument passed to the callback
+ *
+ * The callback is called by sim_run(), before the plane is destroyed.
+ *
+ * */
+void sim_set_departure_hook(sim *, sim_departure_fn, void *);
+
+/**
+ * @brief Lets a plane from elsewhere arrive at the airport
+ * @param sim* Pointer to structure to work on
+ * @param time_t Virtual arrival time in milliseconds, not before the current virtual time
+ * @param char* Name of the plane
+ *
+ * At the arrival time, the plane waits for a bay and a runway like a landing, and is diverted if it gets none in
+ * time. It does not start further operations.
+ *
+ * */
+void sim_add_arrival(sim *, time_t, const char *);
+
+/**
+ * @brief Gets the number of arrivals, which landed
+ * @param sim* Pointer to structure to work on
+ * @return Number of planes from sim_add_arrival(), which are parked, they are counted as landings too
+ *
+ * */
+unsigned long sim_get_arrivals(sim *);
+
+/**
+ * @brief Gets the number of arrivals, which were diverted
+ * @param sim* Pointer to structure to work on
+ * @return Number of planes from sim_add_arrival(), which gave up, they are counted as timeouts too
+ *
+ * */
+unsigned long sim_get_diverted(sim *);
+
+/**
+ * @brief Moves the virtual clock forward
+ * @param sim* Pointer to structure to work on
+ * @param time_t New virtual time in milliseconds, not before the current one
+ *
+ * All pending events are moved by the same amount, so the simulation goes on as before, at a later time. Used to
+ * continue from a checkpoint.
+ *
+ * */
+void sim_set_time(sim *, time_t);
+
+/**
+ * @brief Gets the current virtual time
+ * @param sim* Pointer to structure to work on
+ * @return The virtual time in milliseconds since the start of the simulation
+ *
+ * */
+time_t sim_now(sim *);
+
+/**
+ * @brief Method for getting a string representation of the simulation statistics
+ * @param sim* Pointer to structure to work on
+ * @return A pointer to a string representation of passed structure. Must be freed by caller.
+ *
+ * */
+char *sim_to_string(sim *);
+
+/**
+ * @brief Destructor for sim
+ * @param sim* Pointer to structure to be freed
+ *
+ * Planes, which are on a runway, are destroyed. The airport itself is not freed.
+ *
+ * */
+void sim_destroy(sim *);
+
+#endif /* SIM_H */
@@ -15,20 +15,26 @@
  *
  */
 
+#include <errno.h>
+#include <poll.h>
 #include <pthread.h>
-#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <unistd.h>
 #include "airport.h"
+#include "arrival.h"
+#include "cancel.h"
+#include "logger.h"
+#include "stats.h"
 #include "tools.h"
 
 /**
-* @brief This is set to exit when the application should exit gracefully.
+* @brief Number of parking slots the airport supplies
 *
 * */
-bool airport_exit = false;
+#define NUM_BAYS 10
 
  /**
 * @brief Representation of the airport for the simulation.
@@ -56,7 +62,13 @@ void print_banner()
     printf("%s", "Press p or P followed by return to display the state of the airport.\n");
     printf("%s", "Press q or Q followed by return to terminate the simulation.\n\n");
     printf("%s", "Press return to start the simulation.\n");
-    getchar();
+    fflush(stdout);
+    /* read byte by byte, as stdio would buffer the input meant for the monitor thread */
+    char c;
+    ssize_t n;
+    do {
+        n = read(STDIN_FILENO, &c, 1);
+    } while ((n == 1 && c != '\n') || (n < 0 && errno == EINTR));
 }
 
 /**
@@ -64,53 +76,66 @@ void print_banner()
 *
 * The monitor thread interacts with the user while the airport-simulation is running.
 * To print the state of the airport, the user can press 'p' or 'P'.
-* To exit the application, the user can press 'q' or 'Q'.
+* To exit the application, the user can press 'q' or 'Q', which requests cancellation.
 *
 * */
 void monitor_thread_func()
 {
-    while(!airport_exit) {
-        char c = getchar();
-        if(c == 'p' || c == 'P') {
-            char *c = airport_to_string(ap);
-            printf("%s", c);
-            free(c);
+    struct pollfd fds[2] = {{.fd = STDIN_FILENO, .events = POLLIN}, {.fd = cancel_get_fd(), .events = POLLIN}};
+    while(!cancel_requested()) {
+        if(poll(fds, 2, -1) < 0 || fds[0].revents == 0)
+            continue;
+        char buf[64];
+        ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+        if(n <= 0) {
+            /* end of input, only cancellation can stop the monitor now */
+            fds[0].fd = -1;
+            continue;
         }
-        if(c == 'q' || c == 'Q') {
-            airport_exit = true;
+        for(ssize_t i = 0; i < n; ++i) {
+            if(buf[i] == 'p' || buf[i] == 'P') {
+                char *c = airport_to_string(ap);
+                printf("%s", c);
+                free(c);
+            }
+            if(buf[i] == 'q' || buf[i] == 'Q') {
+                cancel_request();
+            }
         }
     }
 }
 
 /**
 * @brief Landing thread
-* @param int Landing probability
+* @param arrival* Arrival process of the landings
 *
-* The landing thread lands a plane on the airport with the given probability.
+* Every 500ms, the landing thread lands a plane on the airport with the given probability.
 * */
-void landing_thread_func(int prob)
+void landing_thread_func(arrival *process)
 {
-    while(!airport_exit) {
-        if(prob_bool(prob)) {
+    long long next = current_timestamp() + arrival_first(process);
+    while(cancel_sleep_until(next)) {
+        if(arrival_fires(process)) {
             airport_land_plane(ap);
         }
-        msleep(500);
+        next = arrival_next_at(process, next, current_timestamp());
     }
 }
 
 /**
  * @brief Takeoff thread
- * @param int Take-off probability
+ * @param arrival* Arrival process of the take-offs
  *
- * The take-off thread takes off a plane of the airport with the given probability.
+ * Every 500ms, the take-off thread takes off a plane of the airport with the given probability.
  * */
-void takeoff_thread_func(int prob)
+void takeoff_thread_func(arrival *process)
 {
-    while(!airport_exit) {
-        if(prob_bool(prob)) {
+    long long next = current_timestamp() + arrival_first(process);
+    while(cancel_sleep_until(next)) {
+        if(arrival_fires(process)) {
             airport_takeoff_plane(ap);
         }
-        msleep(500);
+        next = arrival_next_at(process, next, current_timestamp());
     }
 }
 
@@ -124,7 +149,7 @@ void takeoff_thread_func(int prob)
 int main(int argc, char **argv)
 {
     /* initialize random seed */
-    srand (time(NULL));
+    rng_seed(time(NULL));
 
     /* set default value for probabilities */
     int landprob = 50;
@@ -150,10 +175,16 @@ int main(int argc, char **argv)
         return -1;
     }
 
+    /* the threads tick every 500ms and operate with the probabilities */
+    arrival landing, takeoff;
+    arrival_init(&landing, "tick", landprob, 1);
+    arrival_init(&takeoff, "tick", takeoffprob, 1);
+
     print_banner();
 
     /* initialize the airport */
-    ap = airport_init("lumans airport");
+    ap = airport_init("lumans airport", NUM_BAYS, 1);
+    logger_init(LOGGER_INFO, stdout, false);
 
     pthread_t landing_thread;
     pthread_t takeoff_thread;
@@ -165,13 +196,14 @@ int main(int argc, char **argv)
 
     /* create three threads */
     pthread_create(&monitor_thread, &attr, (void *(*)(void *))monitor_thread_func, NULL);
-    pthread_create(&landing_thread, &attr, (void *(*)(void *))landing_thread_func, (void *)((uintptr_t)landprob));
-    pthread_create(&takeoff_thread, &attr, (void *(*)(void *))takeoff_thread_func, (void *)((uintptr_t)takeoffprob));
+    pthread_create(&landing_thread, &attr, (void *(*)(void *))landing_thread_func, &landing);
+    pthread_create(&takeoff_thread, &attr, (void *(*)(void *))takeoff_thread_func, &takeoff);
 
     /* wait for all three threads to finish their work */
     pthread_join(monitor_thread, NULL);
     pthread_join(landing_thread, NULL);
     pthread_join(takeoff_thread, NULL);
+    logger_destroy();
 
     /* print the airport before exiting */
     char *c = airport_to_string(ap);
@@ -180,6 +212,9 @@ int main(int argc, char **argv)
 
     /* free the airport object */
     airport_destroy(ap);
+    stats_destroy();
+    arrival_destroy(&landing);
+    arrival_destroy(&takeoff);
 
     return 0;
 }